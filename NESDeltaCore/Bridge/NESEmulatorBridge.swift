@@ -101,7 +101,8 @@ public class NESEmulatorBridge : NSObject, EmulatorBridging
         
         #if NATIVE
         
-        let databaseURL = NES.core.resourceBundle.url(forResource: "NstDatabase", withExtension: "xml")!
+        // Prefer the precompiled binary database, it's mapped instead of parsed.
+        let databaseURL = NES.core.resourceBundle.url(forResource: "NstDatabase", withExtension: "bin") ?? NES.core.resourceBundle.url(forResource: "NstDatabase", withExtension: "xml")!
         databaseURL.withUnsafeFileSystemRepresentation { NESInitialize($0!) }
         
         NESSetAudioCallback { (buffer, size) in
@@ -28,6 +28,15 @@
 // C++
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
 
 // Variables
 Nes::Api::Emulator nes_emulator;
@@ -47,8 +56,11 @@ BufferCallback audioCallback = NULL;
 BufferCallback videoCallback = NULL;
 
 uint16_t audioBuffer[0x8000];
+Nes::Api::Sound::Ring audioRing;
 
-uint8_t videoBuffer[Nes::Api::Video::Output::WIDTH * Nes::Api::Video::Output::HEIGHT * 2];
+// Frames alternate between the two buffers, frame N is complete in videoBuffers[N & 1].
+uint8_t videoBuffers[2][Nes::Api::Video::Output::WIDTH * Nes::Api::Video::Output::HEIGHT * 2];
+unsigned int videoFrameCounter = 0;
 
 char *gameSaveSavePath = NULL;
 char *gameSaveLoadPath = NULL;
@@ -56,6 +68,18 @@ char *gameSaveLoadPath = NULL;
 bool gameLoaded = false;
 char *gamePath = NULL;
 
+void *databaseMapping = NULL;
+size_t databaseMappingSize = 0;
+
+bool fastStart = false;
+bool firstFramePending = false;
+std::string deferredDatabasePath;
+std::vector<Nes::Api::Cheats::Code> deferredCheats;
+
+bool timedInput = false;
+
+double startupPhaseDurations[NESStartupPhaseCount];
+
 static bool NST_CALLBACK AudioLock(void *context, Nes::Api::Sound::Output& audioOutput);
 static void NST_CALLBACK AudioUnlock(void *context, Nes::Api::Sound::Output& audioOutput);
 static bool NST_CALLBACK VideoLock(void *context, Nes::Api::Video::Output& videoOutput);
@@ -76,14 +100,117 @@ double NESFrameDuration()
     return frameDuration;
 }
 
+#pragma mark - Startup Profiling -
+
+static double NESCurrentTime()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return time.tv_sec + time.tv_nsec / 1000000000.0;
+}
+
+static void NESEndStartupPhase(NESStartupPhase phase, double& startTime)
+{
+    double endTime = NESCurrentTime();
+    
+    startupPhaseDurations[phase] = endTime - startTime;
+    startTime = endTime;
+}
+
+void NESSetFastStart(bool enabled)
+{
+    fastStart = enabled;
+}
+
+double NESStartupPhaseDuration(int phase)
+{
+    if (phase < 0 || phase >= NESStartupPhaseCount)
+    {
+        return 0.0;
+    }
+    
+    return startupPhaseDurations[phase];
+}
+
 #pragma mark - Initialization/Deallocation -
 
+static bool NESMapDatabase(const char *databasePath)
+{
+    // Binary databases are used in place, so map the file instead of reading it.
+    int fd = open(databasePath, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    
+    struct stat info;
+    void *mapping = MAP_FAILED;
+    
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    
+    close(fd);
+    
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+    
+    if (NES_FAILED(nes_database.Load(mapping, info.st_size)))
+    {
+        munmap(mapping, info.st_size);
+        return false;
+    }
+    
+    databaseMapping = mapping;
+    databaseMappingSize = info.st_size;
+    
+    return true;
+}
+
+static void NESParseDatabase(const char *databasePath)
+{
+    std::ifstream databaseFileStream(databasePath, std::ifstream::in | std::ifstream::binary);
+    
+    if (NES_SUCCEEDED(nes_database.Load(databaseFileStream)))
+    {
+        nes_database.Enable();
+    }
+}
+
 void NESInitialize(const char *databasePath)
 {
+    double startTime = NESCurrentTime();
+    
     /* Load Database */
-    std::ifstream databaseFileStream(databasePath, std::ifstream::in | std::ifstream::binary);
-    nes_database.Load(databaseFileStream);
-    nes_database.Enable();
+    nes_database.Unload();
+    deferredDatabasePath.clear();
+    
+    if (databaseMapping != NULL)
+    {
+        munmap(databaseMapping, databaseMappingSize);
+        databaseMapping = NULL;
+    }
+    
+    if (NESMapDatabase(databasePath))
+    {
+        nes_database.Enable();
+    }
+    else if (fastStart)
+    {
+        // Parsing the XML takes longer than everything else combined, so leave it until the first frame is up.
+        deferredDatabasePath = databasePath;
+    }
+    else
+    {
+        // Not a binary database, fall back to parsing the XML.
+        NESParseDatabase(databasePath);
+    }
+    
+    NESEndStartupPhase(NESStartupPhaseDatabase, startTime);
     
     /* Prepare Callbacks */
     Nes::Api::Sound::Output::lockCallback.Set(AudioLock, NULL);
@@ -99,6 +226,13 @@ bool NESStartEmulation(const char *gameFilepath)
 {
     gamePath = strdup(gameFilepath);
     
+    for (int phase = NESStartupPhaseLoad; phase < NESStartupPhaseCount; phase++)
+    {
+        startupPhaseDurations[phase] = 0.0;
+    }
+    
+    double startTime = NESCurrentTime();
+    
     /* Load Game */
     std::ifstream gameFileStream(gameFilepath, std::ios::in | std::ios::binary);
     
@@ -111,22 +245,22 @@ bool NESStartEmulation(const char *gameFilepath)
     
     nes_machine.SetMode(nes_machine.GetDesiredMode());
     
+    NESEndStartupPhase(NESStartupPhaseLoad, startTime);
+    
     /* Prepare Audio */
     nes_audio.SetSampleBits(16);
     nes_audio.SetSampleRate(44100);
     nes_audio.SetVolume(Nes::Api::Sound::ALL_CHANNELS, 85);
     nes_audio.SetSpeaker(Nes::Api::Sound::SPEAKER_MONO);
     
-    nes_audioOutput.samples[0] = audioBuffer;
-    nes_audioOutput.length[0] = NESPreferredAudioFrameLength();
-    nes_audioOutput.samples[1] = NULL;
-    nes_audioOutput.length[1] = 0;
+    // Samples are rendered straight into the ring, see AudioLock().
+    audioRing.SetFormat(NESPreferredAudioFrameLength() * 8, 16, 1);
     
     
     /* Prepare Video */
     nes_video.EnableUnlimSprites(true);
     
-    nes_videoOutput.pixels = videoBuffer;
+    nes_videoOutput.pixels = videoBuffers[1];
     nes_videoOutput.pitch = Nes::Api::Video::Output::WIDTH * 2;
     
     Nes::Api::Video::RenderState renderState;
@@ -149,11 +283,16 @@ bool NESStartEmulation(const char *gameFilepath)
     /* Prepare Inputs */
     nes_input.ConnectController(0, Nes::Api::Input::PAD1);
     
+    NESEndStartupPhase(NESStartupPhaseSetup, startTime);
+    
     
     /* Start Emulation */
     nes_machine.Power(true);
     
+    NESEndStartupPhase(NESStartupPhasePower, startTime);
+    
     gameLoaded = true;
+    firstFramePending = true;
     
     return true;
 }
@@ -182,21 +321,120 @@ void* NESReadMemory(int address, int size)
 
 #pragma mark - Game Loop -
 
+static void NESRunDeferredStartup()
+{
+    if (!deferredDatabasePath.empty())
+    {
+        // Only games loaded from now on are looked up, the running one keeps its header setup.
+        NESParseDatabase(deferredDatabasePath.c_str());
+        deferredDatabasePath.clear();
+    }
+    
+    for (size_t index = 0; index < deferredCheats.size(); index++)
+    {
+        nes_cheats.SetCode(deferredCheats[index]);
+    }
+    
+    deferredCheats.clear();
+}
+
+static unsigned long NESInputTime()
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (unsigned long)time.tv_sec * 1000000UL + time.tv_nsec / 1000;
+}
+
+static void NESBeginInputFrame()
+{
+    if (!timedInput)
+    {
+        return;
+    }
+    
+    // Replay what arrived since the previous frame over the span of this one.
+    nes_controllers.timing.begin = nes_controllers.timing.end;
+    nes_controllers.timing.end = NESInputTime();
+}
+
+static void NESEndInputFrame()
+{
+    for (int index = 0; index < Nes::Api::Input::NUM_PADS; index++)
+    {
+        Nes::Api::Input::Controllers::Pad& pad = nes_controllers.pad[index];
+        
+        if (pad.numEvents > 0)
+        {
+            pad.buttons = pad.events[pad.numEvents - 1].buttons;
+            pad.numEvents = 0;
+        }
+    }
+}
+
 void NESRunFrame()
 {
+    NESBeginInputFrame();
+    
+    if (!firstFramePending)
+    {
+        nes_emulator.Execute(&nes_videoOutput, &nes_audioOutput, &nes_controllers);
+        NESEndInputFrame();
+        return;
+    }
+    
+    double startTime = NESCurrentTime();
+    
     nes_emulator.Execute(&nes_videoOutput, &nes_audioOutput, &nes_controllers);
+    NESEndInputFrame();
+    
+    NESEndStartupPhase(NESStartupPhaseFirstFrame, startTime);
+    
+    firstFramePending = false;
+    
+    // The first frame has been handed to the video callback, so catch up on everything fast start put off.
+    NESRunDeferredStartup();
+    
+    NESEndStartupPhase(NESStartupPhaseDeferred, startTime);
 }
 
 #pragma mark - Inputs -
 
+static void NESSetButtons(unsigned int buttons, int playerIndex)
+{
+    Nes::Api::Input::Controllers::Pad& pad = nes_controllers.pad[playerIndex];
+    
+    if (!timedInput)
+    {
+        pad.buttons = buttons;
+        return;
+    }
+    
+    // Once the queue is full, later changes in the same frame overwrite the last one.
+    if (pad.numEvents < Nes::Api::Input::Controllers::Pad::MAX_EVENTS)
+    {
+        pad.numEvents++;
+    }
+    
+    Nes::Api::Input::Controllers::Pad::Event& event = pad.events[pad.numEvents - 1];
+    event.buttons = buttons;
+    event.time = NESInputTime();
+}
+
+static unsigned int NESCurrentButtons(int playerIndex)
+{
+    const Nes::Api::Input::Controllers::Pad& pad = nes_controllers.pad[playerIndex];
+    return (pad.numEvents > 0) ? pad.events[pad.numEvents - 1].buttons : pad.buttons;
+}
+
 void NESActivateInput(int input, int playerIndex)
 {
-    nes_controllers.pad[playerIndex].buttons |= input;
+    NESSetButtons(NESCurrentButtons(playerIndex) | input, playerIndex);
 }
 
 void NESDeactivateInput(int input, int playerIndex)
 {
-    nes_controllers.pad[playerIndex].buttons &= ~input;
+    NESSetButtons(NESCurrentButtons(playerIndex) & ~input, playerIndex);
 }
 
 void NESResetInputs()
@@ -204,9 +442,19 @@ void NESResetInputs()
     for (int index = 0; index < Nes::Api::Input::NUM_PADS ; index++)
     {
         nes_controllers.pad[index].buttons = 0;
+        nes_controllers.pad[index].numEvents = 0;
     }
 }
 
+void NESSetTimedInput(bool enabled)
+{
+    NESEndInputFrame();
+    
+    timedInput = enabled;
+    nes_controllers.timing.begin = 0;
+    nes_controllers.timing.end = NESInputTime();
+}
+
 #pragma mark - Save States -
 
 void NESSaveSaveState(const char *saveStateFilepath)
@@ -266,11 +514,18 @@ bool NESAddCheatCode(const char *cheatCode)
 {
     Nes::Api::Cheats::Code code;
     
+    // Decoding is what validates the code, so only installing it is deferred.
     if (NES_FAILED(Nes::Api::Cheats::GameGenieDecode(cheatCode, code)))
     {
         return false;
     }
     
+    if (fastStart && firstFramePending)
+    {
+        deferredCheats.push_back(code);
+        return true;
+    }
+    
     if (NES_FAILED(nes_cheats.SetCode(code)))
     {
         return false;
@@ -281,9 +536,55 @@ bool NESAddCheatCode(const char *cheatCode)
 
 void NESResetCheats()
 {
+    deferredCheats.clear();
     nes_cheats.ClearCodes();
 }
 
+#pragma mark - Audio -
+
+int NESReadAudio(unsigned char *buffer, int size)
+{
+    unsigned int count = audioRing.Read(buffer, size / sizeof(int16_t));
+    return count * sizeof(int16_t);
+}
+
+int NESAudioBufferFill()
+{
+    return audioRing.GetFilled() * sizeof(int16_t);
+}
+
+unsigned char *NESAudioBuffer()
+{
+    return (unsigned char *)audioBuffer;
+}
+
+int NESAudioBufferSize()
+{
+    return sizeof(audioBuffer);
+}
+
+#pragma mark - Video -
+
+const unsigned char *NESVideoBuffer()
+{
+    return videoBuffers[videoFrameCounter & 1];
+}
+
+const unsigned char *NESVideoBufferForFrame(unsigned int frame)
+{
+    return videoBuffers[frame & 1];
+}
+
+int NESVideoBufferSize()
+{
+    return sizeof(videoBuffers[0]);
+}
+
+const unsigned int *NESVideoFrameCounter()
+{
+    return &videoFrameCounter;
+}
+
 #pragma mark - Callbacks -
 
 void NESSetAudioCallback(BufferCallback callback)
@@ -303,32 +604,42 @@ void NESSetSaveCallback(VoidCallback callback)
 
 static bool NST_CALLBACK AudioLock(void *context, Nes::Api::Sound::Output& audioOutput)
 {
-    return true;
+    return audioRing.Lock(audioOutput, NESPreferredAudioFrameLength());
 }
 
 static void NST_CALLBACK AudioUnlock(void *context, Nes::Api::Sound::Output& audioOutput)
 {
+    audioRing.Unlock(audioOutput);
+    
     if (audioCallback == NULL)
     {
+        // No callback, so host pulls samples from its own audio thread via NESReadAudio().
         return;
     }
     
-    audioCallback((unsigned char *)audioBuffer, NESPreferredAudioFrameLength() * sizeof(int16_t));
+    unsigned int count = audioRing.Read(audioBuffer, audioRing.GetFilled());
+    audioCallback((unsigned char *)audioBuffer, count * sizeof(int16_t));
 }
 
 static bool NST_CALLBACK VideoLock(void *context, Nes::Api::Video::Output& videoOutput)
 {
+    // Render into the buffer not holding the last complete frame.
+    videoOutput.pixels = videoBuffers[(videoFrameCounter + 1) & 1];
     return true;
 }
 
 static void NST_CALLBACK VideoUnlock(void *context, Nes::Api::Video::Output& videoOutput)
 {
+    // Publish the frame to hosts polling the counter rather than waiting on the callback.
+    // Its low bit tells them which buffer the frame is in.
+    __atomic_store_n(&videoFrameCounter, videoFrameCounter + 1, __ATOMIC_RELEASE);
+    
     if (videoCallback == NULL)
     {
         return;
     }
     
-    (*videoCallback)((const unsigned char *)videoBuffer, Nes::Api::Video::Output::WIDTH * Nes::Api::Video::Output::HEIGHT * 2);
+    (*videoCallback)((const unsigned char *)videoOutput.pixels, Nes::Api::Video::Output::WIDTH * Nes::Api::Video::Output::HEIGHT * 2);
 }
 
 static void NST_CALLBACK FileIO(void *context, Nes::Api::User::File& file)
@@ -18,8 +18,28 @@ extern "C"
     typedef void (*BufferCallback)(const unsigned char *_Nonnull buffer, int size);
     typedef void (*VoidCallback)(void);
     
+    // Phases timed from NESInitialize() to the first frame, see NESStartupPhaseDuration().
+    typedef enum NESStartupPhase
+    {
+        NESStartupPhaseDatabase,   // Mapping or parsing the database in NESInitialize().
+        NESStartupPhaseLoad,       // Machine::Load(), including database lookup and board creation.
+        NESStartupPhaseSetup,      // Audio, video render state and controller configuration.
+        NESStartupPhasePower,      // Machine::Power().
+        NESStartupPhaseFirstFrame, // First NESRunFrame(), including palette generation on first blit.
+        NESStartupPhaseDeferred,   // Work postponed by fast start, run right after the first frame.
+        NESStartupPhaseCount
+    } NESStartupPhase;
+    
     double NESFrameDuration();
     
+    // In fast start mode, an XML database is only parsed and enabled after the first frame,
+    // so the first game goes by its header alone. Cheats added before then are installed
+    // after the first frame too. Binary databases are mapped in place and never deferred.
+    void NESSetFastStart(bool fastStart);
+    
+    // Seconds spent in a phase of the most recent start, 0 if it hasn't run yet.
+    double NESStartupPhaseDuration(int phase);
+    
     void NESInitialize(const char *_Nonnull databasePath);
     
     bool NESStartEmulation(const char *_Nonnull gamePath);
@@ -31,6 +51,10 @@ extern "C"
     void NESDeactivateInput(int input, int playerIndex);
     void NESResetInputs();
     
+    // In timed input mode, input changes are stamped with the time they arrive and replayed
+    // within the next frame at the same relative point, instead of all being seen at its start.
+    void NESSetTimedInput(bool timedInput);
+    
     void NESSaveSaveState(const char *_Nonnull saveStatePath);
     void NESLoadSaveState(const char *_Nonnull saveStatePath);
     
@@ -42,6 +66,23 @@ extern "C"
 
     void* NESReadMemory(int address, int size);
     
+    int NESReadAudio(unsigned char *_Nonnull buffer, int size);
+    int NESAudioBufferFill();
+    
+    // Stable buffers for hosts that read frames and samples in place instead of through callbacks.
+    // Video is double-buffered: NESVideoBuffer() is the last complete frame, and frame N of the counter
+    // is in NESVideoBufferForFrame(N). The counter is bumped with release semantics once a frame is complete,
+    // so a reader on another thread can poll it (e.g. Atomics.load over a SharedArrayBuffer) and read that
+    // frame while the next one is rendered into the other buffer. Frame N's buffer is reused for frame N + 2,
+    // so if the counter has moved on by two or more once the read is done, the copy may be torn.
+    // The audio buffer is scratch space to drain into with NESReadAudio(NESAudioBuffer(), NESAudioBufferSize()).
+    const unsigned char *_Nonnull NESVideoBuffer();
+    const unsigned char *_Nonnull NESVideoBufferForFrame(unsigned int frame);
+    int NESVideoBufferSize();
+    const unsigned int *_Nonnull NESVideoFrameCounter();
+    unsigned char *_Nonnull NESAudioBuffer();
+    int NESAudioBufferSize();
+    
     void NESSetAudioCallback(_Nullable BufferCallback audioCallback);
     void NESSetVideoCallback(_Nullable BufferCallback videoCallback);
     void NESSetSaveCallback(_Nullable VoidCallback saveCallback);
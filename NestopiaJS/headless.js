@@ -0,0 +1,67 @@
+// Headless runner for Node: node nestopia-node.js game.nes [frames]
+// Prints the startup phases, the speed and hashes of the last frame and of
+// CPU RAM, so builds can be compared without a browser.
+
+function NESHash(bytes, start, end, hash) {
+  for (var i = start; i < end; i++) {
+    hash = Math.imul(hash ^ bytes[i], 16777619) >>> 0;
+  }
+  return hash;
+}
+
+function NESHeadless() {
+  var fs = require('fs');
+  var path = require('path');
+  var args = process.argv.slice(2);
+  
+  if (args.length < 1) {
+    console.error('usage: node nestopia-node.js game.nes [frames]');
+    process.exit(1);
+  }
+  
+  var frames = args.length > 1 ? parseInt(args[1], 10) : 600;
+  
+  var database = path.join(__dirname, 'NstDatabase.bin');
+  if (!fs.existsSync(database)) {
+    database = path.join(__dirname, 'NstDatabase.xml');
+  }
+  
+  Module.ccall('NESInitialize', null, ['string'], [database]);
+  
+  var audioBytes = 0;
+  
+  if (!Module.ccall('NESStartEmulation', 'boolean', ['string'], [args[0]])) {
+    console.error('Could not load ' + args[0]);
+    process.exit(1);
+  }
+  
+  var start = Date.now();
+  
+  // No callbacks, everything is read in place.
+  for (var i = 0; i < frames; i++) {
+    _NESRunFrame();
+    audioBytes += _NESReadAudio(_NESAudioBuffer(), _NESAudioBufferSize());
+  }
+  
+  var seconds = (Date.now() - start) / 1000;
+  
+  var phases = ['database', 'load', 'setup', 'power', 'first frame', 'deferred'];
+  for (var phase = 0; phase < phases.length; phase++) {
+    console.log(phases[phase] + ': ' + (_NESStartupPhaseDuration(phase) * 1000).toFixed(3) + 'ms');
+  }
+  
+  var ram = _NESReadMemory(0, 0x800);
+  var video = _NESVideoBuffer();
+  var frameHash = NESHash(Module.HEAPU8, video, video + _NESVideoBufferSize(), 2166136261);
+  
+  console.log(Module.HEAPU32[_NESVideoFrameCounter() >> 2] + ' frames in ' + seconds.toFixed(3) + 's (' + (frames / seconds).toFixed(1) + ' fps)');
+  console.log('frame ' + frameHash.toString(16) + ' ram ' + NESHash(Module.HEAPU8, ram, ram + 0x800, 2166136261).toString(16) + ' audio ' + audioBytes);
+  
+  process.exit(0);
+}
+
+if (runtimeInitialized) {
+  NESHeadless();
+} else {
+  Module.onRuntimeInitialized = NESHeadless;
+}
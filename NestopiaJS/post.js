@@ -1,25 +1,97 @@
-Module.ccall('NESInitialize', null, ['string'], ['NstDatabase.xml'])
-  
-var videoCallback = addFunction(function(buffer, size) {
-  var typedArray = Module.HEAPU16.subarray(buffer/2, buffer/2 + size/2);
-  var string = String.fromCharCode.apply(null, typedArray);
-  window.webkit.messageHandlers.NESEmulatorBridge.postMessage({'type': 'video', 'data': string});
-});
+// Views over the bridge's own buffers, so hosts read frames and samples
+// straight out of the heap. They're rebuilt only when memory grows.
+var NESHeap = null;
+var NESVideo = [];
+var NESAudio = null;
+var NESFrameCounter = 0;
 
-_NESSetVideoCallback(videoCallback);
+function NESViews() {
+  if (NESHeap !== Module.HEAPU8.buffer) {
+    NESHeap = Module.HEAPU8.buffer;
+    NESVideo = [0, 1].map(function(frame) { return new Uint8Array(NESHeap, _NESVideoBufferForFrame(frame), _NESVideoBufferSize()); });
+    NESAudio = new Uint8Array(NESHeap, _NESAudioBuffer(), _NESAudioBufferSize());
+    NESFrameCounter = _NESVideoFrameCounter() >> 2;
+  }
+}
 
-var audioCallback = addFunction(function(buffer, size) {
-  var typedArray = Module.HEAPU8.subarray(buffer, buffer + size);
-  var array = Array.from(typedArray);
-  window.webkit.messageHandlers.NESEmulatorBridge.postMessage({'type': 'audio', 'data': array});
-});
+// RGB565 pixels of the last complete frame. Frames alternate between two buffers,
+// so the view stays intact while the next frame renders, but not the one after.
+Module.NESVideoFrame = function() {
+  return NESVideo[Module.NESFrameCount() & 1];
+};
 
-_NESSetAudioCallback(audioCallback);
+// Bumped once per complete frame, poll it to see whether NESVideoFrame() changed.
+Module.NESFrameCount = function() {
+  NESViews();
+  return typeof SharedArrayBuffer !== 'undefined' && NESHeap instanceof SharedArrayBuffer ? Atomics.load(Module.HEAPU32, NESFrameCounter) : Module.HEAPU32[NESFrameCounter];
+};
 
-var saveCallback = addFunction(function() {
-  window.webkit.messageHandlers.NESEmulatorBridge.postMessage({'type': 'save'});
-});
+// Moves pending samples into the audio buffer and returns a view of them.
+// Only for hosts that don't set an audio callback.
+Module.NESDrainAudio = function() {
+  NESViews();
+  var size = _NESReadAudio(_NESAudioBuffer(), _NESAudioBufferSize());
+  return NESAudio.subarray(0, size);
+};
 
-_NESSetSaveCallback(saveCallback);
+function NESStart() {
+  // Prefer the binary database when it's been preloaded, it's mapped instead of parsed.
+  var database = FS.analyzePath('NstDatabase.bin').exists ? 'NstDatabase.bin' : 'NstDatabase.xml';
+  Module.ccall('NESInitialize', null, ['string'], [database])
+  
+  var webkit = typeof window !== 'undefined' && window.webkit && window.webkit.messageHandlers.NESEmulatorBridge;
+  var worker = typeof WorkerGlobalScope !== 'undefined' && self instanceof WorkerGlobalScope;
+  
+  if (webkit) {
+    // Script messages only carry property list values, so WebKit still gets strings and arrays.
+    var videoCallback = addFunction(function(buffer, size) {
+      var typedArray = Module.HEAPU16.subarray(buffer/2, buffer/2 + size/2);
+      var string = String.fromCharCode.apply(null, typedArray);
+      webkit.postMessage({'type': 'video', 'data': string});
+    }, 'vii');
+    
+    _NESSetVideoCallback(videoCallback);
+    
+    var audioCallback = addFunction(function(buffer, size) {
+      var typedArray = Module.HEAPU8.subarray(buffer, buffer + size);
+      var array = Array.from(typedArray);
+      webkit.postMessage({'type': 'audio', 'data': array});
+    }, 'vii');
+    
+    _NESSetAudioCallback(audioCallback);
+    
+    var saveCallback = addFunction(function() {
+      webkit.postMessage({'type': 'save'});
+    }, 'v');
+    
+    _NESSetSaveCallback(saveCallback);
+    
+    webkit.postMessage({'type': 'ready'});
+  } else if (worker) {
+    // The heap can't be transferred, so hand over one copy per frame instead of encoding it.
+    _NESSetVideoCallback(addFunction(function(buffer, size) {
+      var data = Module.HEAPU8.slice(buffer, buffer + size).buffer;
+      postMessage({'type': 'video', 'frame': Module.NESFrameCount(), 'data': data}, [data]);
+    }, 'vii'));
+    
+    _NESSetAudioCallback(addFunction(function(buffer, size) {
+      var data = Module.HEAPU8.slice(buffer, buffer + size).buffer;
+      postMessage({'type': 'audio', 'data': data}, [data]);
+    }, 'vii'));
+    
+    _NESSetSaveCallback(addFunction(function() {
+      postMessage({'type': 'save'});
+    }, 'v'));
+    
+    postMessage({'type': 'ready'});
+  }
+  
+  // Anywhere else the page runs frames itself and reads the views above in between.
+}
 
-window.webkit.messageHandlers.NESEmulatorBridge.postMessage({'type': 'ready'});
\ No newline at end of file
+// asm.js is up by the time this runs, WebAssembly is compiled asynchronously.
+if (runtimeInitialized) {
+  NESStart();
+} else {
+  Module.onRuntimeInitialized = NESStart;
+}
@@ -357,6 +357,8 @@ void retro_set_environment(retro_environment_t cb)
       { "nestopia_palette", "Palette; consumer|canonical|alternative|rgb|cxa2025as|pal|composite-direct-fbx|pvm-style-d93-fbx|ntsc-hardware-fbx|nes-classic-fbx-fs|raw|custom" },
       { "nestopia_nospritelimit", "Remove 8-sprites-per-scanline hardware limit; disabled|enabled" },
       { "nestopia_fds_auto_insert", "Automatically insert first FDS disk on reset; enabled|disabled" },
+      { "nestopia_fds_fast_load", "Fast-forward FDS disk access; disabled|enabled" },
+      { "nestopia_run_ahead", "Run-ahead frames; 0|1|2|3|4" },
       { "nestopia_overscan_v", "Mask Overscan (Vertical); enabled|disabled" },
       { "nestopia_overscan_h", "Mask Overscan (Horizontal); disabled|enabled" },
       { "nestopia_aspect" ,  "Preferred aspect ratio; auto|ntsc|pal|4:3" },
@@ -607,6 +609,16 @@ static void check_variables(void)
 
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
       fds_auto_insert = (strcmp(var.value, "enabled") == 0);
+
+   var.key = "nestopia_fds_fast_load";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+      Api::Fds(emulator).EnableFastLoad(strcmp(var.value, "enabled") == 0);
+
+   var.key = "nestopia_run_ahead";
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var))
+      Api::Machine(emulator).SetRunAhead(atoi(var.value));
    
    var.key = "nestopia_blargg_ntsc_filter";
 
@@ -1140,31 +1152,17 @@ bool retro_load_game_special(unsigned, const struct retro_game_info *, size_t)
 
 size_t retro_serialize_size(void)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return 0;
-   return ss.str().size();
+   return machine->GetStateSize();
 }
 
 bool retro_serialize(void *data, size_t size)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return false;
-
-   std::string state = ss.str();
-   if (state.size() > size)
-      return false;
-
-   std::copy(state.begin(), state.end(), reinterpret_cast<char*>(data));
-   return true;
+   return !machine->SaveState(data, size);
 }
 
 bool retro_unserialize(const void *data, size_t size)
 {
-   std::stringstream ss(std::string(reinterpret_cast<const char*>(data),
-            reinterpret_cast<const char*>(data) + size));
-   return !machine->LoadState(ss);
+   return !machine->LoadState(data, size);
 }
 
 void *retro_get_memory_data(unsigned id)
@@ -418,6 +418,11 @@ namespace Nes
 			}
 		}
 
+		void Apu::EnableCallbacks(const bool enable)
+		{
+			settings.callbacks = enable;
+		}
+
 		void Apu::UpdateSettings()
 		{
 			cycles.Update( settings.rate, settings.speed, cpu );
@@ -834,7 +839,7 @@ namespace Nes
 			{
 				dword streamed = 0;
 
-				if (Sound::Output::lockCallback( *stream ))
+				if (!settings.callbacks || Sound::Output::lockCallback( *stream ))
 				{
 					streamed = stream->length[0] + stream->length[1];
 
@@ -853,7 +858,8 @@ namespace Nes
 							FlushSound<byte,true>();
 					}
 
-					Sound::Output::unlockCallback( *stream );
+					if (settings.callbacks)
+						Sound::Output::unlockCallback( *stream );
 				}
 
 				if (const dword rate = synchronizer.Clock( streamed, settings.rate, cpu ))
@@ -896,7 +902,7 @@ namespace Nes
 		#endif
 
 		Apu::Settings::Settings()
-		: rate(44100), bits(16), speed(0), muted(false), transpose(false), stereo(false), audible(true)
+		: rate(44100), bits(16), speed(0), muted(false), transpose(false), stereo(false), audible(true), callbacks(true)
 		{
 			for (uint i=0; i < MAX_CHANNELS; ++i)
 				volumes[i] = Channel::DEFAULT_VOLUME;
@@ -69,6 +69,7 @@ namespace Nes
 			void   SetAutoTranspose(bool);
 			void   SetGenie(bool);
 			void   EnableStereo(bool);
+			void   EnableCallbacks(bool);
 
 			void SaveState(State::Saver&,dword) const;
 			void LoadState(State::Loader&);
@@ -604,6 +605,7 @@ namespace Nes
 				bool genie;
 				bool stereo;
 				bool audible;
+				bool callbacks;
 				byte volumes[MAX_CHANNELS];
 			};
 
@@ -60,6 +60,7 @@ namespace Nes
 						Ines::Load
 						(
 							context.stream,
+							context.source,
 							context.patch,
 							context.patchBypassChecksum,
 							context.patchResult,
@@ -170,7 +171,7 @@ namespace Nes
 			Log::Suppressor logSupressor;
 			Ram prg, chr;
 			ProfileEx profileEx;
-			Ines::Load( stream, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL );
+			Ines::Load( stream, NULL, NULL, false, NULL, prg, chr, favoredSystem, profile, profileEx, NULL );
 			SetupBoard( prg, chr, NULL, NULL, profile, profileEx, NULL );
 		}
 
@@ -344,8 +345,8 @@ namespace Nes
 				profile.hash.Assign( checksum.GetSha1(), checksum.GetCrc() );
 			}
 
-			if (board)
-				*board = Boards::Board::Create( b );
+			if (board && !(*board = Boards::Board::Create( b )))
+				return RESULT_ERR_UNSUPPORTED_MAPPER;
 
 			return RESULT_OK;
 		}
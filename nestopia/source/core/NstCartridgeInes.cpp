@@ -28,6 +28,7 @@
 #include "NstStream.hpp"
 #include "NstChecksum.hpp"
 #include "NstImageDatabase.hpp"
+#include "NstRomSource.hpp"
 #include "NstCartridge.hpp"
 #include "NstCartridgeInes.hpp"
 
@@ -42,6 +43,7 @@ namespace Nes
 		class Cartridge::Ines::Loader
 		{
 			bool Load(Ram&,dword);
+			byte* Share(dword,dword,dword) const;
 
 			enum TrainerSetup
 			{
@@ -63,6 +65,7 @@ namespace Nes
 			};
 
 			Stream::In stream;
+			const RomSource* const source;
 			const FavoredSystem favoredSystem;
 			Profile& profile;
 			ProfileEx& profileEx;
@@ -76,6 +79,7 @@ namespace Nes
 			Loader
 			(
 				std::istream& stdStreamImage,
+				const RomSource* const s,
 				std::istream* const stdStreamPatch,
 				const bool patchBypassChecksum,
 				Result* const patchResult,
@@ -88,6 +92,7 @@ namespace Nes
 			)
 			:
 			stream        (&stdStreamImage),
+			source        (s),
 			favoredSystem (f),
 			profile       (r),
 			profileEx     (x),
@@ -99,7 +104,14 @@ namespace Nes
 				NST_ASSERT( prg.Empty() && chr.Empty() );
 
 				if (stdStreamPatch)
-					*patchResult = patcher.Load( *stdStreamPatch, stdStreamImage );
+				{
+					// Validate against the source in place rather than a copy of it
+
+					if (source)
+						*patchResult = patcher.Load( *stdStreamPatch, source->Peek( 0, source->Length() ), source->Length() );
+					else
+						*patchResult = patcher.Load( *stdStreamPatch, stdStreamImage );
+				}
 
 				profile = Profile();
 				profileEx = ProfileEx();
@@ -118,8 +130,18 @@ namespace Nes
 					}
 				}
 
-				prg.Set( profile.board.GetPrg() );
-				chr.Set( profile.board.GetChr() );
+				if (trainerSetup == TRAINER_READ)
+				{
+					profileEx.trainer.Set( TRAINER_LENGTH );
+					stream.Read( profileEx.trainer.Mem(), TRAINER_LENGTH );
+				}
+				else if (trainerSetup == TRAINER_IGNORE)
+				{
+					stream.Seek( TRAINER_LENGTH );
+				}
+
+				prg.Set( profile.board.GetPrg(), Share( profile.board.GetPrg(), SIZE_16K, 0 ) );
+				chr.Set( profile.board.GetChr(), Share( profile.board.GetChr(), SIZE_8K, profile.board.GetPrg() ) );
 
 				if (!profile.board.prg.empty())
 				{
@@ -133,16 +155,6 @@ namespace Nes
 						chr.Pin(it->number) = it->function.c_str();
 				}
 
-				if (trainerSetup == TRAINER_READ)
-				{
-					profileEx.trainer.Set( TRAINER_LENGTH );
-					stream.Read( profileEx.trainer.Mem(), TRAINER_LENGTH );
-				}
-				else if (trainerSetup == TRAINER_IGNORE)
-				{
-					stream.Seek( TRAINER_LENGTH );
-				}
-
 				if (Load( prg, 16 ))
 					Log::Flush( "Ines: PRG-ROM was patched" NST_LINEBREAK );
 
@@ -552,14 +564,41 @@ namespace Nes
 			}
 		};
 
+		byte* Cartridge::Ines::Loader::Share(const dword size,const dword minSize,const dword offset) const
+		{
+			// ROMs that need neither patching nor padding are referenced
+			// straight out of the source, so machines loaded from the same
+			// buffer end up sharing it. A patch only forces a copy of the
+			// chips it actually writes to.
+
+			if (source && !patcher.Touches( 16 + offset, size ) && size >= minSize && !(size & (size - 1)))
+				return const_cast<byte*>(source->Peek( offset, size ));
+			else
+				return NULL;
+		}
+
 		bool Cartridge::Ines::Loader::Load(Ram& rom,const dword offset)
 		{
 			if (rom.Size())
 			{
-				if (patcher.Empty())
+				if (!rom.Internal())
+				{
+					stream.Seek( rom.Size() );
+				}
+				else if (patcher.Empty())
 				{
 					stream.Read( rom.Mem(), rom.Size() );
 				}
+				else if (const byte* const src = (source ? source->Peek( 0, rom.Size() ) : NULL))
+				{
+					stream.Seek( rom.Size() );
+
+					if (patcher.Patch( src, rom.Mem(), rom.Size(), offset ))
+					{
+						profile.patched = true;
+						return true;
+					}
+				}
 				else
 				{
 					dword size = stream.Length();
@@ -586,6 +625,7 @@ namespace Nes
 		void Cartridge::Ines::Load
 		(
 			std::istream& stdStreamImage,
+			const RomSource* const source,
 			std::istream* const stdStreamPatch,
 			const bool patchBypassChecksum,
 			Result* const patchResult,
@@ -600,6 +640,7 @@ namespace Nes
 			Loader loader
 			(
 				stdStreamImage,
+				source,
 				stdStreamPatch,
 				patchBypassChecksum,
 				patchResult,
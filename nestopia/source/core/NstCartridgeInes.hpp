@@ -44,6 +44,7 @@ namespace Nes
 			static void Load
 			(
 				std::istream&,
+				const RomSource*,
 				std::istream*,
 				bool,
 				Result*,
@@ -213,8 +213,15 @@ namespace Nes
 
 			interrupt.Reset();
 			hooks.Clear();
+
+			idle.count = CYCLE_MAX;
+			timers.hooks.Clear();
+			timers.clock = CYCLE_MAX;
 			linker.Clear();
 
+			map.prg = NULL;
+			map.prgDirect = 0;
+
 			if (on)
 			{
 				map( 0x0000, 0x07FF ).Set( &ram, &Ram::Peek_Ram_0, &Ram::Poke_Ram_0 );
@@ -240,6 +247,12 @@ namespace Nes
 		{
 			NST_VERIFY( pc == RESET_VECTOR );
 
+			if (map.prg)
+			{
+				for (uint i=0x8000; i <= 0xFFFF; i += SIZE_8K)
+					map.UpdatePrg( i );
+			}
+
 			pc = map.Peek16( RESET_VECTOR );
 
 			if (hard)
@@ -270,6 +283,12 @@ namespace Nes
 			hooks.Remove( hook );
 		}
 
+		void Cpu::AddTimer(const Hook& hook)
+		{
+			timers.hooks.Add( hook );
+			timers.clock = 0;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -383,6 +402,7 @@ namespace Nes
 			{
 				CpuModel stateModel = GetModel();
 				ticks = 0;
+				idle.count = CYCLE_MAX;
 
 				while (const dword chunk = state.Begin())
 				{
@@ -479,6 +499,10 @@ namespace Nes
 
 				NST_VERIFY( cycles.count < cycles.frame );
 
+				// board state is restored separately, let the timers recompute
+				// their deadlines from it before the next instruction
+				timers.clock = 0;
+
 				if (cycles.count >= cycles.frame)
 					cycles.count = 0;
 
@@ -743,7 +767,42 @@ namespace Nes
 
 		template<typename T,typename U>
 		Cpu::IoMap::IoMap(Cpu* cpu,T peek,U poke)
-		: Io::Map<SIZE_64K>( cpu, peek, poke ) {}
+		:
+		Io::Map<SIZE_64K> ( cpu, peek, poke ),
+		prg               ( NULL ),
+		prgDirect         ( 0 )
+		{}
+
+		void Cpu::IoMap::UpdatePrg(const uint address)
+		{
+			if (prg && address >= 0x8000 && address <= 0xFFFF)
+			{
+				const uint page = address >> 13 & 0x3;
+				const Io::Port* NST_RESTRICT port = ports + 0x8000 + page * SIZE_8K;
+
+				prgDirect |= 1U << page;
+
+				for (const Io::Port* const end = port + SIZE_8K; port != end; ++port)
+				{
+					if (!port->SameReader( prgPorts[page] ))
+					{
+						prgDirect &= ~(1U << page);
+						break;
+					}
+				}
+			}
+		}
+
+		void Cpu::SetPrgPages(const byte* const* pages,const Io::Port (&ports)[4])
+		{
+			map.prg = pages;
+
+			for (uint i=0; i < 4; ++i)
+			{
+				map.prgPorts[i] = ports[i];
+				map.UpdatePrg( 0x8000 + i * SIZE_8K );
+			}
+		}
 
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
@@ -752,13 +811,19 @@ namespace Nes
 		inline uint Cpu::IoMap::Peek8(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE );
+
+			const uint offset = address - 0x8000;
+
+			if (offset < SIZE_32K && (prgDirect >> (offset >> 13) & 0x1))
+				return prg[offset >> 13][offset & 0x1FFF];
+
 			return ports[address].Peek( address );
 		}
 
 		inline uint Cpu::IoMap::Peek16(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE-1 );
-			return ports[address].Peek( address ) | ports[address + 1].Peek( address + 1 ) << 8;
+			return Peek8( address ) | Peek8( address + 1 ) << 8;
 		}
 
 		inline void Cpu::IoMap::Poke8(const uint address,const uint data) const
@@ -1126,6 +1191,9 @@ namespace Nes
 			{
 				pc = ((tmp=pc+1) + sign_extend_8(uint(map.Peek8( pc )))) & 0xFFFF;
 				cycles.count += cycles.clock[2 + ((tmp^pc) >> 8 & 1)];
+
+				if (tmp - 2 - pc < IDLE_LOOP_SIZE)
+					IdleLoop( tmp - 2 );
 			}
 			else
 			{
@@ -1249,8 +1317,13 @@ namespace Nes
 
 		NST_SINGLE_CALL void Cpu::JmpAbs()
 		{
+			const uint from = pc - 1;
+
 			pc = map.Peek16( pc );
 			cycles.count += cycles.clock[JMP_ABS_CYCLES-1];
+
+			if (from - pc < IDLE_LOOP_SIZE)
+				IdleLoop( from );
 		}
 
 		NST_SINGLE_CALL void Cpu::JmpInd()
@@ -1889,6 +1962,8 @@ namespace Nes
 			for (const Hook *hook = hooks.Ptr(), *const end = hook+hooks.Size(); hook != end; ++hook)
 				hook->Execute();
 
+			ClockTimers();
+
 			NST_ASSERT( cycles.count >= cycles.frame && interrupt.nmiClock >= cycles.frame );
 
 			cycles.count -= cycles.frame;
@@ -1899,15 +1974,34 @@ namespace Nes
 
 			if (interrupt.irqClock != CYCLE_MAX)
 				interrupt.irqClock = (interrupt.irqClock > cycles.frame ? interrupt.irqClock - cycles.frame : 0);
+
+			if (timers.clock != CYCLE_MAX)
+				timers.clock = (timers.clock > cycles.frame ? timers.clock - cycles.frame : 0);
+		}
+
+		void Cpu::ClockTimers()
+		{
+			timers.clock = CYCLE_MAX;
+
+			for (const Hook *hook = timers.hooks.Ptr(), *const end = hook+timers.hooks.Size(); hook != end; ++hook)
+				hook->Execute();
 		}
 
 		void Cpu::Clock()
 		{
+			idle.count = CYCLE_MAX;
+
+			if (cycles.count >= timers.clock)
+				ClockTimers();
+
 			Cycle clock = apu.Clock();
 
 			if (clock > cycles.frame)
 				clock = cycles.frame;
 
+			if (clock > timers.clock)
+				clock = timers.clock;
+
 			if (cycles.count < interrupt.nmiClock)
 			{
 				if (clock > interrupt.nmiClock)
@@ -2005,6 +2099,119 @@ namespace Nes
 			while (cycles.count < cycles.frame);
 		}
 
+		////////////////////////////////////////////////////////////////////////////////////////
+		// idle loops
+		////////////////////////////////////////////////////////////////////////////////////////
+
+		Cycle Cpu::GetIdleLoopLength(const uint end) const
+		{
+			// Only instructions that neither write memory nor read anything
+			// but zero page or their own operands. Running such a loop body
+			// can't change the machine besides the registers and flags.
+
+			if (pc < 0x8000 || hooks.Size())
+				return 0;
+
+			uint length = 0;
+
+			for (uint address=pc; address != end; )
+			{
+				switch (map.Peek8( address ))
+				{
+					case 0x0A: case 0x18: case 0x2A: case 0x38: case 0x4A:
+					case 0x6A: case 0x88: case 0x8A: case 0x98: case 0xA8:
+					case 0xAA: case 0xB8: case 0xBA: case 0xC8: case 0xCA:
+					case 0xD8: case 0xE8: case 0xEA: case 0xF8:
+
+						address += 1;
+						length += 2;
+						break;
+
+					case 0x09: case 0x29: case 0x49: case 0x69: case 0xA0:
+					case 0xA2: case 0xA9: case 0xC0: case 0xC9: case 0xE0:
+					case 0xE9:
+
+						address += 2;
+						length += 2;
+						break;
+
+					case 0x05: case 0x24: case 0x25: case 0x45: case 0x65:
+					case 0xA4: case 0xA5: case 0xA6: case 0xC4: case 0xC5:
+					case 0xE4: case 0xE5:
+
+						address += 2;
+						length += 3;
+						break;
+
+					case 0x15: case 0x35: case 0x55: case 0x75: case 0xB4:
+					case 0xB5: case 0xB6: case 0xD5: case 0xF5:
+
+						address += 2;
+						length += 4;
+						break;
+
+					default:
+
+						return 0;
+				}
+
+				if (address > end)
+					return 0;
+			}
+
+			if (map.Peek8( end ) == 0x4C)
+				length += JMP_ABS_CYCLES;
+			else
+				length += 3 + (((end + 2) ^ pc) >> 8 & 0x1);
+
+			return length * cycles.clock[0];
+		}
+
+		void Cpu::IdleLoop(const uint end)
+		{
+			// Called at the closing jump of a short loop starting at pc. Two
+			// passes exactly one iteration apart with the same registers and
+			// flags mean a pure loop body has settled, every following pass
+			// will be identical until the next event, so the passes that would
+			// end before it can be skipped.
+
+			if (idle.count != CYCLE_MAX && idle.pc == pc && idle.end == end)
+			{
+				if (!idle.length)
+					return;
+
+				if
+				(
+					cycles.count - idle.count == idle.length &&
+					cycles.count < cycles.round &&
+					idle.a == a &&
+					idle.x == x &&
+					idle.y == y &&
+					idle.flags.nz == flags.nz &&
+					idle.flags.c == flags.c &&
+					idle.flags.v == flags.v &&
+					idle.flags.d == flags.d
+				)
+				{
+					cycles.count += (cycles.round - cycles.count - 1) / idle.length * idle.length;
+					idle.count = cycles.count;
+					return;
+				}
+			}
+			else
+			{
+				idle.pc = pc;
+				idle.end = end;
+				idle.length = GetIdleLoopLength( end );
+			}
+
+			idle.count = cycles.count;
+			idle.a = a;
+			idle.x = x;
+			idle.y = y;
+			idle.flags = flags;
+		}
+
 		uint Cpu::Peek(const uint address) const
 		{
 			return map.Peek8( address );
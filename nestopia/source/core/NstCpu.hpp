@@ -89,6 +89,8 @@ namespace Nes
 			void SetModel(CpuModel);
 			void AddHook(const Hook&);
 			void RemoveHook(const Hook&);
+			void AddTimer(const Hook&);
+			void SetPrgPages(const byte* const*,const Io::Port (&)[4]);
 
 			void SaveState(State::Saver&,dword,dword) const;
 			void LoadState(State::Loader&,dword,dword,dword);
@@ -113,7 +115,8 @@ namespace Nes
 				PLP_CYCLES     = 4,
 				JSR_CYCLES     = 6,
 				JMP_ABS_CYCLES = 3,
-				JMP_IND_CYCLES = 5
+				JMP_IND_CYCLES = 5,
+				IDLE_LOOP_SIZE = 16
 			};
 
 			void Reset(bool,bool);
@@ -127,12 +130,16 @@ namespace Nes
 
 			void DoISR(uint);
 			uint FetchIRQISRVector();
+			void ClockTimers();
 			void Clock();
 
 			void Run0();
 			void Run1();
 			void Run2();
 
+			void IdleLoop(uint);
+			Cycle GetIdleLoopLength(uint) const;
+
 			inline void ExecuteOp();
 			inline uint FetchPc8();
 			inline uint FetchPc16();
@@ -387,6 +394,18 @@ namespace Nes
 				uint d;
 			};
 
+			struct Idle
+			{
+				Cycle count;
+				Cycle length;
+				uint pc;
+				uint end;
+				uint a;
+				uint x;
+				uint y;
+				Flags flags;
+			};
+
 			struct Interrupt
 			{
 				void Reset();
@@ -417,6 +436,12 @@ namespace Nes
 				word capacity;
 			};
 
+			struct Timers
+			{
+				Hooks hooks;
+				Cycle clock;
+			};
+
 			struct Ram
 			{
 				typedef byte (&Ref)[RAM_SIZE];
@@ -445,6 +470,12 @@ namespace Nes
 				inline uint Peek8(uint) const;
 				inline uint Peek16(uint) const;
 				inline void Poke8(uint,uint) const;
+
+				void UpdatePrg(uint);
+
+				const byte* const* prg;
+				Io::Port prgPorts[4];
+				uint prgDirect;
 			};
 
 			class Linker
@@ -477,8 +508,10 @@ namespace Nes
 			uint y;
 			uint sp;
 			Flags flags;
+			Idle idle;
 			Interrupt interrupt;
 			Hooks hooks;
+			Timers timers;
 			uint opcode;
 			word jammed;
 			word model;
@@ -562,6 +595,14 @@ namespace Nes
 				cycles.NextRound( count );
 			}
 
+			void ScheduleTimers(Cycle count)
+			{
+				if (timers.clock > count)
+					timers.clock = count;
+
+				cycles.NextRound( count );
+			}
+
 			Ram::Ref GetRam()
 			{
 				return ram.mem;
@@ -585,13 +626,16 @@ namespace Nes
 			template<typename T,typename U,typename V>
 			const Io::Port* Link(Address address,Level level,T t,U u,V v)
 			{
-				return linker.Add( address, level, Io::Port(t,u,v), map );
+				const Io::Port* const port = linker.Add( address, level, Io::Port(t,u,v), map );
+				map.UpdatePrg( address );
+				return port;
 			}
 
 			template<typename T,typename U,typename V>
 			void Unlink(Address address,T t,U u,V v)
 			{
 				linker.Remove( address, Io::Port(t,u,v), map );
+				map.UpdatePrg( address );
 			}
 		};
 	}
@@ -22,51 +22,221 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
-#include "NstCore.hpp"
+
+#include "NstAssert.hpp"
 #include "NstCrc32.hpp"
 
+#ifndef NST_NO_HW_HASH
+
+ #if defined(__ARM_FEATURE_CRC32)
+
+  #include <arm_acle.h>
+  #define NST_CRC32_ARM
+
+ #elif (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && (NST_GCC >= 409 || defined(__clang__) || NST_MSVC >= 1600)
+
+  #include <emmintrin.h>
+  #include <wmmintrin.h>
+
+  #if NST_MSVC
+   #include <intrin.h>
+   #define NST_TARGET_CLMUL
+  #else
+   #include <cpuid.h>
+   #define NST_TARGET_CLMUL __attribute__((target("pclmul,sse2")))
+  #endif
+
+  #define NST_CRC32_CLMUL
+
+ #endif
+
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Crc32
 		{
-			static dword NST_CALL Iterate(uint data,dword crc)
+			struct Lut
 			{
-				struct Lut
-				{
-					dword data[256];
+				dword data[8][256];
 
-					Lut()
+				Lut()
+				{
+					for (uint i=0; i < 256; ++i)
 					{
-						for (uint i=0; i < 256; ++i)
-						{
-							dword n = i;
+						dword n = i;
 
-							for (uint j=0; j < 8; ++j)
-								n = (n >> 1) ^ (((~n & 1) - 1) & 0xEDB88320);
+						for (uint j=0; j < 8; ++j)
+							n = (n >> 1) ^ (((~n & 1) - 1) & 0xEDB88320);
 
-							data[i] = n;
-						}
+						data[0][i] = n;
 					}
-				};
 
+					// slice-by-8, each table advances the CRC by one more byte
+
+					for (uint i=0; i < 256; ++i)
+					{
+						for (uint j=1; j < 8; ++j)
+							data[j][i] = (data[j-1][i] >> 8) ^ data[0][data[j-1][i] & 0xFF];
+					}
+				}
+			};
+
+			static const Lut& GetLut()
+			{
 				static const Lut lut;
+				return lut;
+			}
+
+			static dword NST_CALL Iterate(uint data,dword crc)
+			{
+				return (crc >> 8) ^ GetLut().data[0][(crc ^ data) & 0xFF];
+			}
+
+			static dword Iterate(const byte* NST_RESTRICT data,dword length,dword crc)
+			{
+				const Lut& lut = GetLut();
+
+				for (; length >= 8; length -= 8, data += 8)
+				{
+					const dword lo = crc ^ (data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24);
+					const dword hi = data[4] | uint(data[5]) << 8 | dword(data[6]) << 16 | dword(data[7]) << 24;
+
+					crc =
+					(
+						lut.data[7][lo & 0xFF] ^ lut.data[6][lo >> 8 & 0xFF] ^ lut.data[5][lo >> 16 & 0xFF] ^ lut.data[4][lo >> 24] ^
+						lut.data[3][hi & 0xFF] ^ lut.data[2][hi >> 8 & 0xFF] ^ lut.data[1][hi >> 16 & 0xFF] ^ lut.data[0][hi >> 24]
+					);
+				}
+
+				for (; length; --length)
+					crc = (crc >> 8) ^ lut.data[0][(crc ^ *data++) & 0xFF];
+
+				return crc;
+			}
+
+			#if defined(NST_CRC32_ARM)
+
+			static dword IterateArm(const byte* NST_RESTRICT data,dword length,dword crc)
+			{
+				for (; length >= 8; length -= 8, data += 8)
+				{
+					const qaword v =
+					(
+						qaword(data[4] | uint(data[5]) << 8 | dword(data[6]) << 16 | dword(data[7]) << 24) << 32 |
+						dword(data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24)
+					);
+
+					crc = __crc32d( crc, v );
+				}
+
+				for (; length; --length)
+					crc = __crc32b( crc, *data++ );
 
-				return (crc >> 8) ^ lut.data[(crc ^ data) & 0xFF];
+				return crc;
 			}
 
+			#elif defined(NST_CRC32_CLMUL)
+
+			static bool HasClmul()
+			{
+				#if NST_MSVC
+				int regs[4];
+				__cpuid( regs, 1 );
+				return regs[2] & (1 << 1);
+				#else
+				unsigned int a, b, c, d;
+				return __get_cpuid( 1, &a, &b, &c, &d ) && (c & bit_PCLMUL);
+				#endif
+			}
+
+			// Carry-less multiplication folding as described in Intel's "Fast CRC
+			// Computation for Generic Polynomials Using PCLMULQDQ Instruction",
+			// constants are for the bit-reflected 0xEDB88320 polynomial. Needs at
+			// least 64 bytes and consumes a multiple of 16.
+
+			NST_TARGET_CLMUL static dword IterateClmul(const byte* NST_RESTRICT data,dword length,dword crc)
+			{
+				NST_ASSERT( length >= 64 && length % 16 == 0 );
+
+				const __m128i k1k2 = _mm_set_epi32( 0x00000001, 0xC6E41596, 0x00000001, 0x54442BD4 );
+				const __m128i k3k4 = _mm_set_epi32( 0x00000000, 0xCCAA009E, 0x00000001, 0x751997D0 );
+				const __m128i k5k0 = _mm_set_epi32( 0x00000000, 0x00000000, 0x00000001, 0x63CD6124 );
+				const __m128i poly = _mm_set_epi32( 0x00000001, 0xF7011641, 0x00000001, 0xDB710641 );
+				const __m128i mask = _mm_set_epi32( 0, ~0, 0, ~0 );
+
+				__m128i x1 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x00) ), _mm_cvtsi32_si128( int(crc) ) );
+				__m128i x2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x10) );
+				__m128i x3 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x20) );
+				__m128i x4 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x30) );
+
+				for (data += 64, length -= 64; length >= 64; data += 64, length -= 64)
+				{
+					x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k1k2, 0x00 ), _mm_clmulepi64_si128( x1, k1k2, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x00) ) );
+					x2 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x2, k1k2, 0x00 ), _mm_clmulepi64_si128( x2, k1k2, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x10) ) );
+					x3 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x3, k1k2, 0x00 ), _mm_clmulepi64_si128( x3, k1k2, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x20) ) );
+					x4 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x4, k1k2, 0x00 ), _mm_clmulepi64_si128( x4, k1k2, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x30) ) );
+				}
+
+				x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x00 ), _mm_clmulepi64_si128( x1, k3k4, 0x11 ) ), x2 );
+				x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x00 ), _mm_clmulepi64_si128( x1, k3k4, 0x11 ) ), x3 );
+				x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x00 ), _mm_clmulepi64_si128( x1, k3k4, 0x11 ) ), x4 );
+
+				for (; length >= 16; data += 16, length -= 16)
+					x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x00 ), _mm_clmulepi64_si128( x1, k3k4, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data) ) );
+
+				// fold 128 to 64 bits
+
+				x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), _mm_clmulepi64_si128( x1, k3k4, 0x10 ) );
+				x1 = _mm_xor_si128( _mm_srli_si128( x1, 4 ), _mm_clmulepi64_si128( _mm_and_si128( x1, mask ), k5k0, 0x00 ) );
+
+				// Barrett reduction to 32 bits
+
+				x2 = _mm_clmulepi64_si128( _mm_and_si128( x1, mask ), poly, 0x10 );
+				x2 = _mm_clmulepi64_si128( _mm_and_si128( x2, mask ), poly, 0x00 );
+				x1 = _mm_xor_si128( x1, x2 );
+
+				return dword(_mm_cvtsi128_si32( _mm_srli_si128( x1, 4 ) ));
+			}
+
+			#endif
+
 			dword NST_CALL Compute(uint data,dword crc)
 			{
 				return Iterate( data, crc ^ 0xFFFFFFFF ) ^ 0xFFFFFFFF;
 			}
 
-			dword NST_CALL Compute(const byte* NST_RESTRICT data,const dword length,dword crc)
+			dword NST_CALL Compute(const byte* NST_RESTRICT data,dword length,dword crc)
 			{
 				crc ^= 0xFFFFFFFF;
 
-				for (const byte* const end=data+length; data != end; ++data)
-					crc = Iterate( *data, crc );
+				#if defined(NST_CRC32_ARM)
+
+				crc = IterateArm( data, length, crc );
+
+				#else
+
+				#if defined(NST_CRC32_CLMUL)
+
+				static const bool clmul = HasClmul();
+
+				if (clmul && length >= 64)
+				{
+					const dword bulk = length & ~dword(15);
+
+					crc = IterateClmul( data, bulk, crc );
+
+					data += bulk;
+					length -= bulk;
+				}
+
+				#endif
+
+				crc = Iterate( data, length, crc );
+
+				#endif
 
 				crc ^= 0xFFFFFFFF;
 
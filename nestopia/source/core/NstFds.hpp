@@ -480,6 +480,11 @@ namespace Nes
 
 		public:
 
+			bool IsDriveBusy() const
+			{
+				return disks.mounting || io.led != Api::Fds::MOTOR_OFF;
+			}
+
 			bool IsAnyDiskInserted() const
 			{
 				return disks.current != Disks::EJECTED;
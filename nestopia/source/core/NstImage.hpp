@@ -42,6 +42,7 @@ namespace Nes
 		}
 
 		class ImageDatabase;
+		class RomSource;
 		class Cpu;
 		class Apu;
 		class Ppu;
@@ -73,6 +74,7 @@ namespace Nes
 				Apu& apu;
 				Ppu& ppu;
 				std::istream& stream;
+				const RomSource* const source;
 				std::istream* const patch;
 				const bool patchBypassChecksum;
 				Result* const patchResult;
@@ -81,8 +83,8 @@ namespace Nes
 				const ImageDatabase* const database;
 				Result result;
 
-				Context(Type t,Cpu& c,Apu& a,Ppu& p,std::istream& s,std::istream* h,bool k,Result* r,FavoredSystem f,bool b,const ImageDatabase* d)
-				: type(t), cpu(c), apu(a), ppu(p), stream(s), patch(h), patchBypassChecksum(k), patchResult(r), favoredSystem(f), askProfile(b), database(d), result(RESULT_OK) {}
+				Context(Type t,Cpu& c,Apu& a,Ppu& p,std::istream& s,const RomSource* o,std::istream* h,bool k,Result* r,FavoredSystem f,bool b,const ImageDatabase* d)
+				: type(t), cpu(c), apu(a), ppu(p), stream(s), source(o), patch(h), patchBypassChecksum(k), patchResult(r), favoredSystem(f), askProfile(b), database(d), result(RESULT_OK) {}
 			};
 
 			static Image* Load(Context&);
@@ -30,6 +30,7 @@
 #include <map>
 #include <algorithm>
 #include "NstLog.hpp"
+#include "NstStream.hpp"
 #include "NstImageDatabase.hpp"
 #include "NstXml.hpp"
 
@@ -911,8 +912,107 @@ namespace Nes
 					sibling->Finalize( lut );
 			}
 
+			static void Put(Vector<dword>& out,const String& string,wcstring const lut)
+			{
+				out.Append( static_cast<wcstring>(string) - lut );
+			}
+
+			static void Put(Vector<dword>& out,const Hash& hash)
+			{
+				out.Append( hash.GetCrc32() );
+				out.Append( hash.GetSha1(), Hash::SHA1_WORD_LENGTH );
+			}
+
+			static void Put(Vector<dword>& out,const Ic& ic,wcstring const lut)
+			{
+				Put( out, ic.package, lut );
+				out.Append( ic.pins.size() );
+
+				for (Ic::Pins::const_iterator it(ic.pins.begin()), end(ic.pins.end()); it != end; ++it)
+				{
+					out.Append( it->number );
+					Put( out, it->function, lut );
+				}
+			}
+
 		public:
 
+			class Record;
+
+			static Item* Load(Record&,wcstring);
+
+			void Save(Vector<dword>& out,wcstring const lut) const
+			{
+				Put( out, hash );
+				Put( out, dump.by, lut );
+				Put( out, dump.date, lut );
+				out.Append( dump.state );
+
+				const String* const strings[] =
+				{
+					&title, &altTitle, &clss, &subClss, &catalog, &publisher, &developer,
+					&portDeveloper, &region, &revision, &pcb, &board, &cic
+				};
+
+				for (uint i=0; i < sizeof(array(strings)); ++i)
+					Put( out, *strings[i], lut );
+
+				out.Append( players );
+				out.Append( dword(peripherals[0]) | dword(peripherals[1]) << 8 | dword(peripherals[2]) << 16 | dword(peripherals[3]) << 24 );
+				out.Append( system );
+				out.Append( cpu );
+				out.Append( ppu );
+				out.Append( mapper );
+				out.Append( solderPads );
+				out.Append( multiRegion );
+
+				out.Append( properties.size() );
+
+				for (Properties::const_iterator it(properties.begin()), end(properties.end()); it != end; ++it)
+				{
+					Put( out, it->name, lut );
+					Put( out, it->value, lut );
+				}
+
+				for (uint i=0; i < 2; ++i)
+				{
+					const Roms& roms = (i ? chr : prg);
+					out.Append( roms.size() );
+
+					for (Roms::const_iterator it(roms.begin()), end(roms.end()); it != end; ++it)
+					{
+						out.Append( it->id );
+						Put( out, it->name, lut );
+						out.Append( it->size );
+						Put( out, it->hash );
+						Put( out, *it, lut );
+					}
+				}
+
+				for (uint i=0; i < 2; ++i)
+				{
+					const Rams& rams = (i ? vram : wram);
+					out.Append( rams.size() );
+
+					for (Rams::const_iterator it(rams.begin()), end(rams.end()); it != end; ++it)
+					{
+						out.Append( it->id );
+						out.Append( it->size );
+						out.Append( it->battery );
+						Put( out, *it, lut );
+					}
+				}
+
+				out.Append( chips.size() );
+
+				for (Chips::const_iterator it(chips.begin()), end(chips.end()); it != end; ++it)
+				{
+					Put( out, it->type, lut );
+					out.Append( it->battery );
+					Put( out, *it, lut );
+				}
+			}
+
 			struct Less
 			{
 				bool operator () (const Item* a,const Item* b) const
@@ -999,12 +1099,229 @@ namespace Nes
 			};
 		};
 
+		class ImageDatabase::Item::Record
+		{
+			const byte* pos;
+			const byte* const end;
+			const dword numStrings;
+
+		public:
+
+			Record(const byte* b,const byte* e,dword n)
+			: pos(b), end(e), numStrings(n) {}
+
+			dword Get()
+			{
+				if (end - pos < 4)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				const dword value = pos[0] | uint(pos[1]) << 8 | dword(pos[2]) << 16 | dword(pos[3]) << 24;
+				pos += 4;
+
+				return value;
+			}
+
+			dword GetCount()
+			{
+				const dword count = Get();
+
+				if (count > dword(end - pos) / 4)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				return count;
+			}
+
+			dword GetString()
+			{
+				const dword id = Get();
+
+				if (id >= numStrings)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				return id;
+			}
+
+			Hash GetHash()
+			{
+				const dword crc = Get();
+				dword sha1[Hash::SHA1_WORD_LENGTH];
+
+				for (uint i=0; i < Hash::SHA1_WORD_LENGTH; ++i)
+					sha1[i] = Get();
+
+				return Hash( sha1, crc );
+			}
+
+			void GetPins(Ic::Pins& pins)
+			{
+				pins.resize( GetCount() );
+
+				for (Ic::Pins::iterator it(pins.begin()), end(pins.end()); it != end; ++it)
+				{
+					it->number = Get();
+					it->function = String( GetString() );
+				}
+			}
+		};
+
+		ImageDatabase::Item* ImageDatabase::Item::Load(Record& record,wcstring const lut)
+		{
+			Item* head = NULL;
+
+			try
+			{
+				Item* last = NULL;
+
+				for (dword count=record.GetCount(); count; --count)
+				{
+					const Hash hash( record.GetHash() );
+					const dword dumpBy = record.GetString();
+					const dword dumpDate = record.GetString();
+					const Profile::Dump::State dumpState = static_cast<Profile::Dump::State>(record.Get());
+
+					dword strings[13];
+
+					for (uint i=0; i < sizeof(array(strings)); ++i)
+						strings[i] = record.GetString();
+
+					const dword players = record.Get();
+					const dword packed = record.Get();
+					const byte peripherals[MAX_PERIPHERALS] =
+					{
+						byte(packed >> 0), byte(packed >> 8), byte(packed >> 16), byte(packed >> 24)
+					};
+
+					const Profile::System::Type system = static_cast<Profile::System::Type>(record.Get());
+					const Profile::System::Cpu cpu = static_cast<Profile::System::Cpu>(record.Get());
+					const Profile::System::Ppu ppu = static_cast<Profile::System::Ppu>(record.Get());
+					const uint mapper = record.Get();
+					const uint solderPads = record.Get();
+					const bool multiRegion = record.Get();
+
+					Properties properties( record.GetCount() );
+
+					for (Properties::iterator it(properties.begin()), end(properties.end()); it != end; ++it)
+					{
+						it->name = String( record.GetString() );
+						it->value = String( record.GetString() );
+					}
+
+					Roms roms[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						roms[i].resize( record.GetCount() );
+
+						for (Roms::iterator it(roms[i].begin()), end(roms[i].end()); it != end; ++it)
+						{
+							it->id = record.Get();
+							it->name = String( record.GetString() );
+							it->size = record.Get();
+							it->hash = record.GetHash();
+							it->package = String( record.GetString() );
+							record.GetPins( it->pins );
+						}
+					}
+
+					Rams rams[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						rams[i].resize( record.GetCount() );
+
+						for (Rams::iterator it(rams[i].begin()), end(rams[i].end()); it != end; ++it)
+						{
+							it->id = record.Get();
+							it->size = record.Get();
+							it->battery = record.Get();
+							it->package = String( record.GetString() );
+							record.GetPins( it->pins );
+						}
+					}
+
+					Chips chips( record.GetCount() );
+
+					for (Chips::iterator it(chips.begin()), end(chips.end()); it != end; ++it)
+					{
+						it->type = String( record.GetString() );
+						it->battery = record.Get();
+						it->package = String( record.GetString() );
+						record.GetPins( it->pins );
+					}
+
+					Item* const item = new Item
+					(
+						hash,
+						dumpBy,
+						dumpDate,
+						dumpState,
+						strings[0],
+						strings[1],
+						strings[2],
+						strings[3],
+						strings[4],
+						strings[5],
+						strings[6],
+						strings[7],
+						strings[8],
+						properties,
+						players,
+						peripherals,
+						system,
+						cpu,
+						ppu,
+						strings[9],
+						strings[11],
+						strings[10],
+						mapper,
+						roms[0],
+						roms[1],
+						rams[0],
+						rams[1],
+						chips,
+						strings[12],
+						solderPads
+					);
+
+					item->multiRegion = multiRegion;
+
+					if (last)
+						last->sibling = item;
+					else
+						head = item;
+
+					last = item;
+				}
+			}
+			catch (...)
+			{
+				delete head;
+				throw;
+			}
+
+			if (!head)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			head->Finalize( lut );
+
+			return head;
+		}
+
 		ImageDatabase::ImageDatabase()
 		: enabled(true)
 		{
 			items.begin = NULL;
 			items.end = NULL;
 			items.hashing = HASHING_DETECT;
+
+			binary.data = NULL;
+			binary.keys = NULL;
+			binary.records = NULL;
+			binary.lut = NULL;
+			binary.size = 0;
+			binary.numKeys = 0;
+			binary.recordsSize = 0;
+			binary.numStrings = 0;
 		}
 
 		ImageDatabase::~ImageDatabase()
@@ -1012,6 +1329,62 @@ namespace Nes
 			Unload();
 		}
 
+		const ImageDatabase::Item* ImageDatabase::Find(const Hash& hash) const
+		{
+			if (!binary.keys)
+			{
+				const Item** item = std::lower_bound( items.begin, items.end, hash, Item::Less() );
+				return (item != items.end && (*item)->GetHash() == hash) ? *item : NULL;
+			}
+
+			// keys are sorted like the item list, the entry behind
+			// a key is only decoded the first time it's looked up
+
+			dword lo = 0, hi = binary.numKeys;
+
+			while (lo < hi)
+			{
+				const dword mid = (lo + hi) / 2;
+				Item::Record key( binary.keys + mid * BINARY_KEY, binary.keys + (mid+1) * BINARY_KEY, 0 );
+
+				const Hash keyHash( key.GetHash() );
+
+				if (keyHash < hash)
+				{
+					lo = mid + 1;
+				}
+				else if (hash < keyHash)
+				{
+					hi = mid;
+				}
+				else
+				{
+					if (!items.begin[mid])
+					{
+						const dword offset = key.Get();
+
+						if (offset >= binary.recordsSize)
+							return NULL;
+
+						try
+						{
+							Item::Record record( binary.records + offset, binary.records + binary.recordsSize, binary.numStrings );
+							items.begin[mid] = Item::Load( record, binary.lut );
+						}
+						catch (...)
+						{
+							NST_DEBUG_MSG("corrupt database record!");
+							return NULL;
+						}
+					}
+
+					return items.begin[mid];
+				}
+			}
+
+			return NULL;
+		}
+
 		ImageDatabase::Entry ImageDatabase::Search(const Hash& hash,const FavoredSystem favoredSystem) const
 		{
 			if (items.begin)
@@ -1022,11 +1395,9 @@ namespace Nes
 					( items.hashing & HASHING_CRC  ) ? hash.GetCrc32() : 0UL
 				);
 
-				const Item** item = std::lower_bound( items.begin, items.end, searchHash, Item::Less() );
-
-				if (item != items.end && (*item)->GetHash() == searchHash)
+				if (const Item* const item = Find( searchHash ))
 				{
-					for (const Item* it = *item; it; it = it->GetNextSibling())
+					for (const Item* it = item; it; it = it->GetNextSibling())
 					{
 						switch (it->GetSystem())
 						{
@@ -1068,7 +1439,7 @@ namespace Nes
 						}
 					}
 
-					return *item;
+					return item;
 				}
 			}
 
@@ -1181,10 +1552,209 @@ namespace Nes
 				item->Fill( profile, full );
 		}
 
+		Result ImageDatabase::Load(const void* const data,const dword size)
+		{
+			Unload();
+
+			return Attach( static_cast<const byte*>(data), size );
+		}
+
+		Result ImageDatabase::Attach(const byte* const data,const dword size)
+		{
+			Item::Record header( data, data + NST_MIN(size,dword(BINARY_HEADER)), 0 );
+
+			try
+			{
+				if (header.Get() != BINARY_ID)
+					return RESULT_ERR_INVALID_FILE;
+
+				if (header.Get() != BINARY_VERSION)
+					return RESULT_ERR_UNSUPPORTED_FILE_VERSION;
+
+				const dword format = header.Get();
+				binary.numKeys = header.Get();
+				binary.recordsSize = header.Get();
+				binary.numStrings = header.Get();
+
+				const uint hashing = format & 0xFF;
+				const uint charSize = format >> 8 & 0xFF;
+
+				if
+				(
+					(hashing & ~uint(HASHING_SHA1|HASHING_CRC)) || !hashing ||
+					(charSize != 2 && charSize != 4) ||
+					!binary.numKeys || !binary.numStrings ||
+					binary.numKeys > (size - BINARY_HEADER) / BINARY_KEY ||
+					binary.recordsSize > size - BINARY_HEADER - binary.numKeys * BINARY_KEY ||
+					binary.numStrings != (size - BINARY_HEADER - binary.numKeys * BINARY_KEY - binary.recordsSize) / charSize ||
+					binary.numStrings * charSize != size - BINARY_HEADER - binary.numKeys * BINARY_KEY - binary.recordsSize
+				)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				binary.data = data;
+				binary.size = size;
+				binary.keys = data + BINARY_HEADER;
+				binary.records = binary.keys + binary.numKeys * BINARY_KEY;
+
+				const byte* const pool = binary.records + binary.recordsSize;
+
+				{
+					const dword probe = 1;
+
+					if (charSize == sizeof(wchar_t) && *reinterpret_cast<const byte*>(&probe) && !(reinterpret_cast<std::size_t>(pool) % sizeof(wchar_t)))
+					{
+						binary.lut = reinterpret_cast<wcstring>(pool);
+					}
+					else
+					{
+						strings.Resize( binary.numStrings );
+
+						for (dword i=0; i < binary.numStrings; ++i)
+						{
+							const byte* const src = pool + i * charSize;
+							strings[i] = (charSize == 2) ? (src[0] | uint(src[1]) << 8) : (src[0] | uint(src[1]) << 8 | dword(src[2]) << 16 | dword(src[3]) << 24);
+						}
+
+						binary.lut = strings.Begin();
+					}
+				}
+
+				if (binary.lut[binary.numStrings-1])
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				items.begin = new const Item* [binary.numKeys];
+				items.end = items.begin + binary.numKeys;
+				items.hashing = hashing;
+
+				std::fill( items.begin, items.end, static_cast<const Item*>(NULL) );
+			}
+			catch (Result result)
+			{
+				Unload( true );
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				Unload( true );
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+
+			Log() << "Database: "
+                  << binary.numKeys
+                  << " items mapped from binary DB" NST_LINEBREAK;
+
+			return RESULT_OK;
+		}
+
+		Result ImageDatabase::Save(std::ostream& stdStream) const
+		{
+			if (!items.begin)
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				Stream::Out stream( &stdStream );
+
+				if (binary.data)
+				{
+					stream.Write( binary.data, binary.size );
+					return RESULT_OK;
+				}
+
+				const dword numKeys = items.end - items.begin;
+
+				Vector<dword> keys;
+				Vector<dword> records;
+
+				keys.Reserve( numKeys * (BINARY_KEY / 4) );
+
+				for (const Item** it = items.begin; it != items.end; ++it)
+				{
+					const Hash& hash = (*it)->GetHash();
+
+					keys.Append( hash.GetCrc32() );
+					keys.Append( hash.GetSha1(), Hash::SHA1_WORD_LENGTH );
+					keys.Append( records.Size() * 4 );
+
+					dword count = 0;
+
+					for (const Item* item = *it; item; item = item->GetNextSibling())
+						++count;
+
+					records.Append( count );
+
+					for (const Item* item = *it; item; item = item->GetNextSibling())
+						item->Save( records, strings.Begin() );
+				}
+
+				stream.Write32( BINARY_ID );
+				stream.Write32( BINARY_VERSION );
+				stream.Write32( items.hashing | sizeof(wchar_t) << 8 );
+				stream.Write32( numKeys );
+				stream.Write32( records.Size() * 4 );
+				stream.Write32( strings.Size() );
+
+				for (const dword* it = keys.Begin(); it != keys.End(); ++it)
+					stream.Write32( *it );
+
+				for (const dword* it = records.Begin(); it != records.End(); ++it)
+					stream.Write32( *it );
+
+				for (const wchar_t* it = strings.Begin(); it != strings.End(); ++it)
+				{
+					if (sizeof(wchar_t) == 2)
+						stream.Write16( *it & 0xFFFF );
+					else
+						stream.Write32( *it & 0xFFFFFFFF );
+				}
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
 		Result ImageDatabase::Load(std::istream& baseStream,std::istream* overrideStream)
 		{
 			Unload();
 
+			try
+			{
+				Stream::In stream( &baseStream );
+
+				if (stream.Length() >= 4 && stream.Peek32() == BINARY_ID)
+				{
+					if (overrideStream)
+						return RESULT_ERR_UNSUPPORTED;
+
+					image.Resize( stream.Length() );
+					stream.Read( image.Begin(), image.Size() );
+				}
+			}
+			catch (Result result)
+			{
+				Unload( true );
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				Unload( true );
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+
+			if (image.Size())
+				return Attach( image.Begin(), image.Size() );
+
 			try
 			{
 				Xml baseXml, overrideXml;
@@ -1637,6 +2207,16 @@ namespace Nes
 
 			items.hashing = HASHING_DETECT;
 
+			binary.data = NULL;
+			binary.keys = NULL;
+			binary.records = NULL;
+			binary.lut = NULL;
+			binary.size = 0;
+			binary.numKeys = 0;
+			binary.recordsSize = 0;
+			binary.numStrings = 0;
+
+			image.Destroy();
 			strings.Destroy();
 
 			if (error)
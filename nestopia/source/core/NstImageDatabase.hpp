@@ -101,9 +101,14 @@ namespace Nes
 
 			Entry Search(const Hash&,FavoredSystem) const;
 
+			Result Load(const void*,dword);
+			Result Save(std::ostream&) const;
+
 		private:
 
 			Result Load(std::istream&,std::istream*);
+			Result Attach(const byte*,dword);
+			const Item* Find(const Hash&) const;
 			void Unload(bool);
 
 			typedef Vector<wchar_t> Strings;
@@ -119,7 +124,11 @@ namespace Nes
 				MAX_IC_PINS    = 127,
 				HASHING_DETECT = 0x0,
 				HASHING_SHA1   = 0x1,
-				HASHING_CRC    = 0x2
+				HASHING_CRC    = 0x2,
+				BINARY_ID      = AsciiId<'N','D','B'>::V | 0x1A000000,
+				BINARY_VERSION = 1,
+				BINARY_HEADER  = 24,
+				BINARY_KEY     = 4 * (1 + Hash::SHA1_WORD_LENGTH + 1)
 			};
 
 			ibool enabled;
@@ -133,6 +142,20 @@ namespace Nes
 
 			Strings strings;
 
+			struct
+			{
+				const byte* data;
+				const byte* keys;
+				const byte* records;
+				wcstring lut;
+				dword size;
+				dword numKeys;
+				dword recordsSize;
+				dword numStrings;
+			}   binary;
+
+			Vector<byte> image;
+
 		public:
 
 			Result Load(std::istream& stream)
@@ -0,0 +1,241 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "NstCore.hpp"
+#include "NstAssert.hpp"
+#include "NstLz4.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Lz4
+		{
+			// LZ4 block format, greedy single-probe matcher; trades ratio for speed
+
+			enum
+			{
+				MIN_MATCH  = 4,
+				LAST_LITERALS = 5,
+				MATCH_LIMIT = 12,
+				MAX_OFFSET = 0xFFFF,
+				HASH_BITS  = 12,
+				SKIP_SHIFT = 6
+			};
+
+			static inline dword Read32(const byte* p)
+			{
+				dword data;
+				std::memcpy( &data, p, 4 );
+				return data;
+			}
+
+			static inline uint Hash(dword data)
+			{
+				return (data * 2654435761U) >> (32 - HASH_BITS) & ((1U << HASH_BITS) - 1);
+			}
+
+			static byte* PutLength(byte* dst,ulong length)
+			{
+				for (; length >= 0xFF; length -= 0xFF)
+					*dst++ = 0xFF;
+
+				*dst++ = length;
+
+				return dst;
+			}
+
+			static byte* PutSequence(byte* dst,const byte* const dstEnd,const byte* literals,const ulong numLiterals,const uint offset,const ulong matchLength)
+			{
+				// token, literal count, literals, offset, match length; NULL if it won't fit
+
+				if (ulong(dstEnd - dst) < 1 + numLiterals + numLiterals / 0xFF + 1 + 2 + matchLength / 0xFF + 1)
+					return NULL;
+
+				byte* const token = dst++;
+
+				if (numLiterals >= 0xF)
+				{
+					*token = 0xF << 4;
+					dst = PutLength( dst, numLiterals - 0xF );
+				}
+				else
+				{
+					*token = numLiterals << 4;
+				}
+
+				std::memcpy( dst, literals, numLiterals );
+				dst += numLiterals;
+
+				if (offset)
+				{
+					*dst++ = offset >> 0 & 0xFF;
+					*dst++ = offset >> 8 & 0xFF;
+
+					const ulong length = matchLength - MIN_MATCH;
+
+					if (length >= 0xF)
+					{
+						*token |= 0xF;
+						dst = PutLength( dst, length - 0xF );
+					}
+					else
+					{
+						*token |= length;
+					}
+				}
+
+				return dst;
+			}
+
+			ulong Compress(const byte* const src,const ulong srcSize,byte* const dst,const ulong dstSize)
+			{
+				if (!srcSize || !dstSize)
+					return 0;
+
+				NST_ASSERT( src && dst );
+
+				const byte* const srcEnd = src + srcSize;
+				const byte* const dstEnd = dst + dstSize;
+
+				const byte* NST_RESTRICT ip = src;
+				const byte* anchor = src;
+				byte* NST_RESTRICT op = dst;
+
+				if (srcSize > MATCH_LIMIT)
+				{
+					dword table[1U << HASH_BITS];
+					std::memset( table, 0, sizeof(table) );
+
+					const byte* const matchEnd = srcEnd - LAST_LITERALS;
+
+					for (const byte* const limit = srcEnd - MATCH_LIMIT; ip < limit; )
+					{
+						const dword data = Read32( ip );
+						dword* const entry = table + Hash( data );
+						const byte* const ref = src + *entry;
+						*entry = ip - src;
+
+						if (ref < ip && ulong(ip - ref) <= MAX_OFFSET && Read32( ref ) == data)
+						{
+							ulong length = MIN_MATCH;
+
+							while (ip + length < matchEnd && ip[length] == ref[length])
+								++length;
+
+							if (NULL == (op = PutSequence( op, dstEnd, anchor, ip - anchor, ip - ref, length )))
+								return 0;
+
+							ip += length;
+							anchor = ip;
+						}
+						else
+						{
+							ip += 1 + ((ip - anchor) >> SKIP_SHIFT);
+						}
+					}
+				}
+
+				if (NULL == (op = PutSequence( op, dstEnd, anchor, srcEnd - anchor, 0, 0 )))
+					return 0;
+
+				return op - dst;
+			}
+
+			static bool GetLength(const byte*& src,const byte* const srcEnd,ulong& length)
+			{
+				for (;;)
+				{
+					if (src == srcEnd)
+						return false;
+
+					const uint data = *src++;
+					length += data;
+
+					if (data != 0xFF)
+						return true;
+				}
+			}
+
+			ulong Uncompress(const byte* src,const ulong srcSize,byte* const dst,const ulong dstSize)
+			{
+				if (!srcSize || !dstSize)
+					return 0;
+
+				NST_ASSERT( src && dst );
+
+				const byte* const srcEnd = src + srcSize;
+				byte* op = dst;
+				byte* const dstEnd = dst + dstSize;
+
+				for (;;)
+				{
+					const uint token = *src++;
+
+					ulong length = token >> 4;
+
+					if (length == 0xF && !GetLength( src, srcEnd, length ))
+						return 0;
+
+					if (length > ulong(srcEnd - src) || length > ulong(dstEnd - op))
+						return 0;
+
+					std::memcpy( op, src, length );
+					op += length;
+					src += length;
+
+					if (src == srcEnd)
+						break;
+
+					if (srcEnd - src < 2)
+						return 0;
+
+					const uint offset = src[0] | uint(src[1]) << 8;
+					src += 2;
+
+					if (!offset || offset > ulong(op - dst))
+						return 0;
+
+					length = token & 0xF;
+
+					if (length == 0xF && !GetLength( src, srcEnd, length ))
+						return 0;
+
+					length += MIN_MATCH;
+
+					if (length > ulong(dstEnd - op) || src == srcEnd)
+						return 0;
+
+					// ref trails op by offset and may read back bytes just written
+
+					for (const byte *ref = op - offset, *const end = op + length; op != end; )
+						*op++ = *ref++;
+				}
+
+				return op - dst;
+			}
+		}
+	}
+}
@@ -50,6 +50,7 @@ namespace Nes
 		image         (NULL),
 		cheats        (NULL),
 		imageDatabase (NULL),
+		stateBase     (NULL),
 		ppu           (cpu)
 		{
 		}
@@ -58,6 +59,7 @@ namespace Nes
 		{
 			Unload();
 
+			delete stateBase;
 			delete imageDatabase;
 			delete cheats;
 			delete expPort;
@@ -71,6 +73,7 @@ namespace Nes
 		Result Machine::Load
 		(
 			std::istream& imageStream,
+			const RomSource* const imageSource,
 			FavoredSystem system,
 			bool ask,
 			std::istream* const patchStream,
@@ -88,6 +91,7 @@ namespace Nes
 				cpu.GetApu(),
 				ppu,
 				imageStream,
+				imageSource,
 				patchStream,
 				patchBypassChecksum,
 				patchResult,
@@ -148,6 +152,9 @@ namespace Nes
 
 			tracker.Unload();
 
+			if (stateBase)
+				stateBase->Reset();
+
 			Image::Unload( image );
 			image = NULL;
 
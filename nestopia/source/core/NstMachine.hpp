@@ -56,9 +56,15 @@ namespace Nes
 			class Controllers;
 		}
 
+		namespace State
+		{
+			class Baseline;
+		}
+
 		class Image;
 		class Cheats;
 		class ImageDatabase;
+		class RomSource;
 
 		class Machine
 		{
@@ -84,6 +90,7 @@ namespace Nes
 			Result Load
 			(
 				std::istream&,
+				const RomSource*,
 				FavoredSystem,
 				bool,
 				std::istream*,
@@ -129,6 +136,7 @@ namespace Nes
 			Image* image;
 			Cheats* cheats;
 			ImageDatabase* imageDatabase;
+			State::Baseline* stateBase;
 			Tracker tracker;
 			Ppu ppu;
 			Video::Renderer renderer;
@@ -276,6 +276,11 @@ namespace Nes
 				return pages.mem[page];
 			}
 
+			const byte* const* GetPages() const
+			{
+				return pages.mem;
+			}
+
 			void Poke(uint address,uint data)
 			{
 				const uint page = address >> MEM_PAGE_SHIFT;
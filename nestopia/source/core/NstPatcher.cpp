@@ -96,6 +96,21 @@ namespace Nes
 			return result;
 		}
 
+		Result Patcher::Load(std::istream& patchStream,const byte* const src,const dword size)
+		{
+			Result result = Load( patchStream );
+
+			if (NES_SUCCEEDED(result))
+			{
+				result = Test( src, size );
+
+				if (NES_FAILED(result))
+					Destroy();
+			}
+
+			return result;
+		}
+
 		Result Patcher::Save(std::ostream& stream) const
 		{
 			return
@@ -165,6 +180,15 @@ namespace Nes
 			);
 		}
 
+		bool Patcher::Touches(const dword offset,const dword length) const
+		{
+			return
+			(
+				ips ? ips->Touches( offset, length ) :
+				ups ? ups->Touches( offset, length ) : false
+			);
+		}
+
 		Result Patcher::Create(const Type type,const byte* const src,const byte* const dst,const dword length)
 		{
 			Destroy();
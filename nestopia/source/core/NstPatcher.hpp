@@ -59,12 +59,14 @@ namespace Nes
 
 			Result Load(std::istream&);
 			Result Load(std::istream&,std::istream&);
+			Result Load(std::istream&,const byte*,dword);
 			Result Test(std::istream&) const;
 			Result Test(const byte*,dword) const;
 			Result Test(const Block*,uint) const;
 			Result Save(std::ostream&) const;
 			Result Create(Type,const byte*,const byte*,dword);
 			bool   Patch(const byte*,byte*,dword,dword=0) const;
+			bool   Touches(dword,dword) const;
 			void   Destroy();
 			bool   Empty() const;
 
@@ -88,7 +88,7 @@ namespace Nes
 					blocks.push_back(Block());
 					Block& block = blocks.back();
 
-					block.data = NULL;
+					block.data = 0;
 					block.offset = dword(data[0]) << 16 | uint(data[1]) << 8 | data[2];
 
 					stream.Read( data, 2 );
@@ -96,9 +96,13 @@ namespace Nes
 
 					if (block.length)
 					{
+						// Record data goes into one buffer rather than
+						// an allocation each, large patches have thousands
+
 						block.fill = NO_FILL;
-						block.data = new byte [block.length];
-						stream.Read( block.data, block.length );
+						block.data = payload.size();
+						payload.resize( payload.size() + block.length );
+						stream.Read( &payload[block.data], block.length );
 					}
 					else
 					{
@@ -169,7 +173,7 @@ namespace Nes
 					stream.Write( data, 2 );
 
 					if (it->fill == NO_FILL)
-						stream.Write( it->data, it->length );
+						stream.Write( &payload[it->data], it->length );
 					else
 						stream.Write8( it->fill );
 				}
@@ -231,7 +235,7 @@ namespace Nes
 					const dword part = NST_MIN(it->length,length-pos);
 
 					if (it->fill == NO_FILL)
-						std::memcpy( dst + pos, it->data, part );
+						std::memcpy( dst + pos, &payload[it->data], part );
 					else
 						std::memset( dst + pos, it->fill, part );
 
@@ -242,6 +246,19 @@ namespace Nes
 			return patched;
 		}
 
+		bool Ips::Touches(const dword offset,const dword length) const
+		{
+			for (Blocks::const_iterator it(blocks.begin()), end(blocks.end()); it != end; ++it)
+			{
+				if (it->offset < offset)
+					continue;
+
+				return it->offset < offset + length;
+			}
+
+			return false;
+		}
+
 		Result Ips::Create(const byte* const src,const byte* const dst,const dword length)
 		{
 			NST_ASSERT( !length || (src && dst) );
@@ -278,7 +295,7 @@ namespace Nes
 						blocks.push_back(Block());
 						Block& block = blocks.back();
 
-						block.data = NULL;
+						block.data = 0;
 						block.offset = j;
 
 						uint c = dst[j];
@@ -325,8 +342,8 @@ namespace Nes
 							block.fill = NO_FILL;
 							block.length = k - j;
 
-							block.data = new byte [block.length];
-							std::memcpy( block.data, dst + j, block.length );
+							block.data = payload.size();
+							payload.insert( payload.end(), dst + j, dst + k );
 						}
 
 						j = k;
@@ -355,10 +372,8 @@ namespace Nes
 
 		void Ips::Destroy()
 		{
-			for (Blocks::iterator it(blocks.begin()), end(blocks.end()); it != end; ++it)
-				delete [] it->data;
-
 			blocks.clear();
+			payload.clear();
 		}
 	}
 }
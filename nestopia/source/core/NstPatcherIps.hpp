@@ -54,6 +54,7 @@ namespace Nes
 			Result Save(std::ostream&) const;
 			Result Create(const byte*,const byte*,dword);
 			bool Patch(const byte*,byte*,dword,dword=0) const;
+			bool Touches(dword,dword) const;
 			void Destroy();
 
 		private:
@@ -70,7 +71,7 @@ namespace Nes
 
 			struct Block
 			{
-				byte* data;
+				dword data;
 				dword offset;
 				word length;
 				word fill;
@@ -79,6 +80,7 @@ namespace Nes
 			typedef std::vector<Block> Blocks;
 
 			Blocks blocks;
+			std::vector<byte> payload;
 
 		public:
 
@@ -320,10 +320,21 @@ namespace Nes
 				if (Crc32::Compute( src, srcSize ) != srcCrc)
 					return RESULT_ERR_INVALID_CRC;
 
+				// The target is rebuilt a block at a time so the CRC
+				// runs over whole buffers instead of single bytes
+
+				byte block[SIZE_4K];
 				dword crc = 0;
 
-				for (dword i=0, n=dstSize; i < n; ++i)
-					crc = Crc32::Compute( (i < size ? src[i] : 0U) ^ patch[i], crc );
+				for (dword i=0; i < dstSize; )
+				{
+					const dword n = NST_MIN(dstSize-i,dword(SIZE_4K));
+
+					for (dword j=0; j < n; ++j, ++i)
+						block[j] = (i < size ? src[i] : 0U) ^ patch[i];
+
+					crc = Crc32::Compute( block, n, crc );
+				}
 
 				if (crc != dstCrc)
 					return RESULT_ERR_INVALID_CRC;
@@ -340,13 +351,38 @@ namespace Nes
 
 			if (dstSize || src != dst)
 			{
-				for (dword i=0, end=dstSize; i < size; ++i)
-					dst[i] = src[i] ^ (offset < end ? patched |= patch[offset], patch[offset++] : 0U);
+				dword length = 0;
+
+				if (offset < dstSize)
+				{
+					length = NST_MIN(dstSize-offset,size);
+					const byte* const NST_RESTRICT mask = patch + offset;
+
+					for (dword i=0; i < length; ++i)
+					{
+						patched |= mask[i];
+						dst[i] = src[i] ^ mask[i];
+					}
+				}
+
+				if (src != dst && length < size)
+					std::memcpy( dst + length, src + length, size - length );
 			}
 
 			return patched;
 		}
 
+		bool Ups::Touches(const dword offset,const dword length) const
+		{
+			for (dword i=offset, end=(offset < dstSize ? NST_MIN(dstSize-offset,length) : 0) + offset; i < end; ++i)
+			{
+				if (patch[i])
+					return true;
+			}
+
+			return false;
+		}
+
 		Result Ups::Create(const byte* const src,const byte* const dst,const dword size)
 		{
 			NST_ASSERT( !size || (src && dst) );
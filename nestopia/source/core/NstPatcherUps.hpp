@@ -48,6 +48,7 @@ namespace Nes
 			Result Test(const byte* NST_RESTRICT,dword,bool) const;
 			Result Create(const byte*,const byte*,dword);
 			bool Patch(const byte*,byte*,dword,dword=0) const;
+			bool Touches(dword,dword) const;
 			void Destroy();
 
 		private:
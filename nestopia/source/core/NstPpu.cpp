@@ -244,6 +244,8 @@ namespace Nes
 
 			io.address = 0;
 			io.pattern = 0;
+			io.edge = 0;
+			io.every = 0;
 			io.line.Unset();
 
 			tiles.pattern[0] = 0;
@@ -271,9 +273,12 @@ namespace Nes
 			screen.Clear();
 		}
 
-		uint Ppu::SetAddressLineHook(const Core::Io::Line& line)
+		uint Ppu::SetAddressLineHook(const Core::Io::Line& line,const uint edge)
 		{
 			io.line = line;
+			io.edge = (line ? edge : 0);
+			io.every = (line && !edge);
+
 			return io.address;
 		}
 
@@ -336,6 +341,8 @@ namespace Nes
 			if (model == PPU_RP2C02)
 				state.Begin( AsciiId<'F','R','M'>::V ).Write8( (regs.frame & Regs::FRAME_ODD) == 0 ).End();
 
+			state.Begin( AsciiId<'B','U','S'>::V ).Write16( io.address ).End();
+
 			if (cycles.hClock == HCLOCK_BOOT)
 				state.Begin( AsciiId<'P','O','W'>::V ).Write8( 0x0 ).End();
 
@@ -392,6 +399,11 @@ namespace Nes
 
 						break;
 
+					case AsciiId<'B','U','S'>::V:
+
+						io.address = state.Read16() & 0x3FFF;
+						break;
+
 					case AsciiId<'P','O','W'>::V:
 
 						cycles.hClock = HCLOCK_BOOT;
@@ -412,6 +424,7 @@ namespace Nes
 		void Ppu::ChrMem::ResetAccessor()
 		{
 			accessor.Set( this, &ChrMem::Access_Pattern );
+			direct = true;
 		}
 
 		void Ppu::NmtMem::ResetAccessors()
@@ -637,7 +650,7 @@ namespace Nes
 
 		NST_FORCE_INLINE uint Ppu::Chr::FetchPattern(uint address) const
 		{
-			return accessor.Fetch( address & 0x1FFF );
+			return direct ? Peek( address & 0x1FFF ) : accessor.Fetch( address & 0x1FFF );
 		}
 
 		NST_FORCE_INLINE uint Ppu::Nmt::FetchName(uint address) const
@@ -653,10 +666,12 @@ namespace Nes
 		NST_FORCE_INLINE void Ppu::UpdateAddressLine(uint address)
 		{
 			NST_ASSERT( address <= 0x3FFF );
+
+			const uint rising = ~io.address & address;
 			io.address = address;
 
-			if (io.line)
-				io.line.Toggle( io.address, GetCycles() );
+			if ((rising & io.edge) | io.every)
+				io.line.Toggle( address, GetCycles() );
 		}
 
 		NST_FORCE_INLINE void Ppu::UpdateVramAddress()
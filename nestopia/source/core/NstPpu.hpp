@@ -60,6 +60,12 @@ namespace Nes
 				SCANLINE_VBLANK = 240
 			};
 
+			enum AddressLine
+			{
+				ADDRESS_LINE_ANY = 0x0000,
+				ADDRESS_LINE_A12 = 0x1000
+			};
+
 			enum NmtMirroring
 			{
 				NMT_H = 0xC,
@@ -71,7 +77,7 @@ namespace Nes
 			void SetModel(PpuModel,bool);
 			void SetMirroring(NmtMirroring);
 			void SetMirroring(const byte (&)[4]);
-			uint SetAddressLineHook(const Core::Io::Line&);
+			uint SetAddressLineHook(const Core::Io::Line&,uint=ADDRESS_LINE_ANY);
 			void SetHActiveHook(const Hook&);
 			void SetHBlankHook(const Hook&);
 			uint GetPixelCycles() const;
@@ -87,6 +93,7 @@ namespace Nes
 			protected:
 
 				Io::Accessor accessor;
+				bool direct;
 
 			public:
 
@@ -96,6 +103,7 @@ namespace Nes
 				void SetAccessor(T t,U u)
 				{
 					accessor.Set( t, u );
+					direct = false;
 				}
 			};
 
@@ -393,6 +401,8 @@ namespace Nes
 				uint pattern;
 				uint latch;
 				uint buffer;
+				uint edge;
+				uint every;
 				Core::Io::Line line;
 			};
 
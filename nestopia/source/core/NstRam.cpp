@@ -228,6 +228,22 @@ namespace Nes
 			}
 		}
 
+		void Ram::Unshare()
+		{
+			if (mem && !internal)
+			{
+				byte* const m = static_cast<byte*>(std::malloc( mask+1 ));
+
+				if (!m)
+					throw RESULT_ERR_OUT_OF_MEMORY;
+
+				std::memcpy( m, mem, mask+1 );
+
+				mem = m;
+				internal = true;
+			}
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -56,6 +56,7 @@ namespace Nes
 			void Destroy();
 			void Fill(uint) const;
 			void Mirror(dword);
+			void Unshare();
 
 			Ram& operator = (const Ram&);
 
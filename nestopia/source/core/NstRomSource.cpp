@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "NstAssert.hpp"
+#include "NstRomSource.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		RomSource::RomSource(const void* const data,const dword length)
+		{
+			NST_ASSERT( data || !length );
+
+			char* const begin = const_cast<char*>(static_cast<const char*>(data));
+			setg( begin, begin, begin + length );
+		}
+
+		RomSource::pos_type RomSource::seekoff(const off_type offset,const std::ios_base::seekdir dir,const std::ios_base::openmode which)
+		{
+			const off_type next = offset + (dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? off_type(gptr() - eback()) : off_type(egptr() - eback()));
+
+			if (!(which & std::ios_base::in) || next < 0 || next > off_type(egptr() - eback()))
+				return pos_type(off_type(-1));
+
+			setg( eback(), eback() + next, egptr() );
+
+			return pos_type(next);
+		}
+
+		RomSource::pos_type RomSource::seekpos(const pos_type position,const std::ios_base::openmode which)
+		{
+			return seekoff( off_type(position), std::ios_base::beg, which );
+		}
+
+		const byte* RomSource::Peek(const dword offset,const dword length) const
+		{
+			if (dword(egptr() - gptr()) >= offset && dword(egptr() - gptr()) - offset >= length)
+				return reinterpret_cast<const byte*>(gptr() + offset);
+			else
+				return NULL;
+		}
+
+		dword RomSource::Length() const
+		{
+			return egptr() - gptr();
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
@@ -32,6 +32,31 @@
 #include "NstAssert.hpp"
 #include "NstSha1.hpp"
 
+#ifndef NST_NO_HW_HASH
+
+ #if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+
+  #include <arm_neon.h>
+  #define NST_SHA1_ARM
+
+ #elif (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)) && (NST_GCC >= 409 || defined(__clang__) || NST_MSVC >= 1900)
+
+  #include <immintrin.h>
+
+  #if NST_MSVC
+   #include <intrin.h>
+   #define NST_TARGET_SHA
+  #else
+   #include <cpuid.h>
+   #define NST_TARGET_SHA __attribute__((target("sha,sse4.1,ssse3")))
+  #endif
+
+  #define NST_SHA1_X86
+
+ #endif
+
+#endif
+
 namespace Nes
 {
 	namespace Core
@@ -95,6 +120,157 @@ namespace Nes
 			#undef NST_R3
 			#undef NST_R4
 
+			#if defined(NST_SHA1_ARM)
+
+			// Four rounds per step, W is the current message quad and the
+			// schedule for the next is computed from the previous four
+
+			#define NST_STEP(w,op,k,i) \
+			{                                                                                   \
+				if (i >= 4)                                                                     \
+					w[i&3] = vsha1su1q_u32( vsha1su0q_u32( w[i&3], w[(i+1)&3], w[(i+2)&3] ), w[(i+3)&3] ); \
+                                                                                                \
+				const uint32_t next = vsha1h_u32( vgetq_lane_u32( abcd, 0 ) );                  \
+				abcd = op( abcd, e, vaddq_u32( w[i&3], vdupq_n_u32( k ) ) );                    \
+				e = next;                                                                       \
+			}
+
+			static void Process(dword* const NST_RESTRICT state,const byte* NST_RESTRICT data,dword blocks)
+			{
+				uint32x4_t abcd = vsetq_lane_u32( state[0], vdupq_n_u32( 0 ), 0 );
+				abcd = vsetq_lane_u32( state[1], abcd, 1 );
+				abcd = vsetq_lane_u32( state[2], abcd, 2 );
+				abcd = vsetq_lane_u32( state[3], abcd, 3 );
+				uint32_t e = state[4];
+
+				for (; blocks; --blocks, data += 64)
+				{
+					const uint32x4_t abcdSaved = abcd;
+					const uint32_t eSaved = e;
+
+					uint32x4_t w[4];
+
+					for (uint i=0; i < 4; ++i)
+						w[i] = vreinterpretq_u32_u8( vrev32q_u8( vld1q_u8( data + i * 16 ) ) );
+
+					NST_STEP(w,vsha1cq_u32,0x5A827999, 0) NST_STEP(w,vsha1cq_u32,0x5A827999, 1) NST_STEP(w,vsha1cq_u32,0x5A827999, 2) NST_STEP(w,vsha1cq_u32,0x5A827999, 3) NST_STEP(w,vsha1cq_u32,0x5A827999, 4)
+					NST_STEP(w,vsha1pq_u32,0x6ED9EBA1, 5) NST_STEP(w,vsha1pq_u32,0x6ED9EBA1, 6) NST_STEP(w,vsha1pq_u32,0x6ED9EBA1, 7) NST_STEP(w,vsha1pq_u32,0x6ED9EBA1, 8) NST_STEP(w,vsha1pq_u32,0x6ED9EBA1, 9)
+					NST_STEP(w,vsha1mq_u32,0x8F1BBCDC,10) NST_STEP(w,vsha1mq_u32,0x8F1BBCDC,11) NST_STEP(w,vsha1mq_u32,0x8F1BBCDC,12) NST_STEP(w,vsha1mq_u32,0x8F1BBCDC,13) NST_STEP(w,vsha1mq_u32,0x8F1BBCDC,14)
+					NST_STEP(w,vsha1pq_u32,0xCA62C1D6,15) NST_STEP(w,vsha1pq_u32,0xCA62C1D6,16) NST_STEP(w,vsha1pq_u32,0xCA62C1D6,17) NST_STEP(w,vsha1pq_u32,0xCA62C1D6,18) NST_STEP(w,vsha1pq_u32,0xCA62C1D6,19)
+
+					abcd = vaddq_u32( abcd, abcdSaved );
+					e += eSaved;
+				}
+
+				state[0] = vgetq_lane_u32( abcd, 0 );
+				state[1] = vgetq_lane_u32( abcd, 1 );
+				state[2] = vgetq_lane_u32( abcd, 2 );
+				state[3] = vgetq_lane_u32( abcd, 3 );
+				state[4] = e;
+			}
+
+			#undef NST_STEP
+
+			#else
+
+			#if defined(NST_SHA1_X86)
+
+			static bool HasShaNi()
+			{
+				#if NST_MSVC
+				int regs[4];
+				__cpuid( regs, 0 );
+
+				if (regs[0] < 7)
+					return false;
+
+				__cpuid( regs, 1 );
+
+				if ((regs[2] & (1 << 19 | 1 << 9)) != (1 << 19 | 1 << 9))
+					return false;
+
+				__cpuidex( regs, 7, 0 );
+				return regs[1] & (1 << 29);
+				#else
+				unsigned int a, b, c, d;
+
+				if (__get_cpuid_max( 0, NULL ) < 7 || !__get_cpuid( 1, &a, &b, &c, &d ) || (c & (bit_SSE4_1|bit_SSSE3)) != (bit_SSE4_1|bit_SSSE3))
+					return false;
+
+				__cpuid_count( 7, 0, a, b, c, d );
+				return b & (1U << 29);
+				#endif
+			}
+
+			// Same stepping as the ARM version, the E register trails one
+			// step behind as sha1nexte derives it from the previous ABCD
+
+			#define NST_STEP(w,f,i) \
+			{                                                                                                  \
+				if (i < 4)                                                                                     \
+					w[i] = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + i * 16) ), order ); \
+				else                                                                                           \
+					w[i&3] = _mm_sha1msg2_epu32( _mm_xor_si128( _mm_sha1msg1_epu32( w[i&3], w[(i+1)&3] ), w[(i+2)&3] ), w[(i+3)&3] ); \
+                                                                                                               \
+				const __m128i prev = abcd;                                                                     \
+				abcd = _mm_sha1rnds4_epu32( abcd, i ? _mm_sha1nexte_epu32( e, w[i&3] ) : _mm_add_epi32( e, w[0] ), f ); \
+				e = prev;                                                                                      \
+			}
+
+			NST_TARGET_SHA static void ProcessShaNi(dword* const NST_RESTRICT state,const byte* NST_RESTRICT data,dword blocks)
+			{
+				const __m128i order = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+
+				__m128i abcd = _mm_set_epi32( int(state[0]), int(state[1]), int(state[2]), int(state[3]) );
+				__m128i e = _mm_set_epi32( int(state[4]), 0, 0, 0 );
+
+				for (; blocks; --blocks, data += 64)
+				{
+					const __m128i abcdSaved = abcd;
+					const __m128i eSaved = e;
+
+					__m128i w[4];
+
+					NST_STEP(w,0, 0) NST_STEP(w,0, 1) NST_STEP(w,0, 2) NST_STEP(w,0, 3) NST_STEP(w,0, 4)
+					NST_STEP(w,1, 5) NST_STEP(w,1, 6) NST_STEP(w,1, 7) NST_STEP(w,1, 8) NST_STEP(w,1, 9)
+					NST_STEP(w,2,10) NST_STEP(w,2,11) NST_STEP(w,2,12) NST_STEP(w,2,13) NST_STEP(w,2,14)
+					NST_STEP(w,3,15) NST_STEP(w,3,16) NST_STEP(w,3,17) NST_STEP(w,3,18) NST_STEP(w,3,19)
+
+					e = _mm_sha1nexte_epu32( e, eSaved );
+					abcd = _mm_add_epi32( abcd, abcdSaved );
+				}
+
+				state[0] = dword(_mm_extract_epi32( abcd, 3 ));
+				state[1] = dword(_mm_extract_epi32( abcd, 2 ));
+				state[2] = dword(_mm_extract_epi32( abcd, 1 ));
+				state[3] = dword(_mm_extract_epi32( abcd, 0 ));
+				state[4] = dword(_mm_extract_epi32( e, 3 ));
+			}
+
+			#undef NST_STEP
+
+			#endif
+
+			static void Process(dword* const NST_RESTRICT state,const byte* NST_RESTRICT data,dword blocks)
+			{
+				#if defined(NST_SHA1_X86)
+
+				static const bool shaNi = HasShaNi();
+
+				if (shaNi)
+				{
+					ProcessShaNi( state, data, blocks );
+					return;
+				}
+
+				#endif
+
+				for (; blocks; --blocks, data += 64)
+					Transform( state, data );
+			}
+
+			#endif
+
 			void NST_CALL Compute(Key& key,const byte* data,dword length)
 			{
 				if (length)
@@ -160,10 +336,10 @@ namespace Nes
 					i = 64 - j;
 
 					std::memcpy( buffer+j, data, i );
-					Transform( state, buffer );
+					Process( state, buffer, 1 );
 
-					for (; i + 63 < length; i += 64)
-						Transform( state, data+i );
+					Process( state, data+i, (length - i) / 64 );
+					i += (length - i) & ~dword(63);
 
 					j = 0;
 				}
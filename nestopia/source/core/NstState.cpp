@@ -22,8 +22,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include "NstState.hpp"
 #include "NstZlib.hpp"
+#include "NstLz4.hpp"
 
 namespace Nes
 {
@@ -31,32 +33,61 @@ namespace Nes
 	{
 		namespace State
 		{
-			enum Compression
-			{
-				NO_COMPRESSION,
-				ZLIB_COMPRESSION
-			};
-
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("s", on)
 			#endif
 
-			Saver::Saver(StdStream p,bool c,bool i,dword append)
-			: stream(p), chunks(CHUNK_RESERVE), useCompression(c), internal(i)
+			enum
+			{
+				// chunk method byte after the codecs, memory pages that
+				// differ from the same block in the baseline
+				BASELINE_PAGES = 3
+			};
+
+			Baseline::Baseline()
 			{
-				NST_COMPILE_ASSERT( CHUNK_RESERVE >= 2 );
+				Reset();
+			}
 
-				chunks.SetTo(1);
-				chunks.Front() = 0;
+			void Baseline::Reset()
+			{
+				data.Destroy();
+				blocks.Destroy();
+			}
+
+			Saver::Saver(StdStream p,Compression c,bool i,dword append,uint l,Baseline* b)
+			:
+			stream      (p),
+			compression (c == ZLIB_COMPRESSION && !Zlib::AVAILABLE ? FAST_COMPRESSION : c),
+			level       (l),
+			internal    (i),
+			capture     (b && b->Empty()),
+			block       (0),
+			baseline    (b)
+			{
+				NST_ASSERT( level >= MIN_ZLIB_LEVEL && level <= MAX_ZLIB_LEVEL );
+				chunks.Push( 0 );
 
 				if (append)
 				{
-					chunks.SetTo(2);
-					chunks[1] = append;
+					chunks.Push( append );
 					stream.Seek( 4 + 4 + append );
 				}
 			}
 
+			Saver::Saver(byte* data,dword size,bool i)
+			:
+			stream      (data,size),
+			compression (NO_COMPRESSION),
+			level       (MAX_ZLIB_LEVEL),
+			internal    (i),
+			capture     (false),
+			block       (0),
+			baseline    (NULL)
+			{
+				chunks.Push( 0 );
+			}
+
 			Saver::~Saver()
 			{
 				NST_VERIFY( chunks.Size() == 1 );
@@ -70,7 +101,7 @@ namespace Nes
 			{
 				stream.Write32( chunk );
 				stream.Write32( 0 );
-				chunks.Append( 0 );
+				chunks.Push( 0 );
 
 				return *this;
 			}
@@ -124,18 +155,94 @@ namespace Nes
 				return *this;
 			}
 
+			void Baseline::Capture(const byte* const mem,const dword length)
+			{
+				blocks.Append( data.Size() );
+				data.Append( mem, length );
+			}
+
+			const byte* Baseline::Block(const uint index,const dword length) const
+			{
+				if (index < blocks.Size() && (index+1 < blocks.Size() ? blocks[index+1] : data.Size()) - blocks[index] == length)
+					return data.Begin() + blocks[index];
+
+				return NULL;
+			}
+
+			dword Baseline::Diff(const byte* const NST_RESTRICT mem,const dword length,const uint index,byte* const NST_RESTRICT dirty) const
+			{
+				const byte* const base = Block( index, length );
+				NST_ASSERT( base );
+
+				dword count = 0;
+
+				for (dword offset=0, page=0; offset < length; offset += PAGE_SIZE, ++page)
+				{
+					const dword size = NST_MIN(length - offset,dword(PAGE_SIZE));
+
+					if (std::memcmp( mem + offset, base + offset, size ))
+					{
+						dirty[page >> 3] |= 1U << (page & 7);
+						count += size;
+					}
+				}
+
+				return count;
+			}
+
 			Saver& Saver::Compress(const byte* const data,const dword length)
 			{
 				NST_VERIFY( length );
 
-				if (Zlib::AVAILABLE && useCompression && length > 1)
+				const uint index = block++;
+
+				if (baseline)
+				{
+					if (capture)
+					{
+						baseline->Capture( data, length );
+					}
+					else if (baseline->Block( index, length ))
+					{
+						// only the pages written since the baseline was taken
+
+						const dword numPages = (length + Baseline::PAGE_SIZE - 1) >> Baseline::PAGE_SHIFT;
+						const dword mapSize = (numPages + 7) >> 3;
+
+						buffer.Resize( mapSize );
+						std::memset( buffer.Begin(), 0, mapSize );
+
+						const dword dirty = baseline->Diff( data, length, index, buffer.Begin() );
+
+						chunks.Back() += 1 + 4 + mapSize + dirty;
+						stream.Write8( BASELINE_PAGES );
+						stream.Write32( index );
+						stream.Write( buffer.Begin(), mapSize );
+
+						for (dword page=0; page < numPages; ++page)
+						{
+							if (buffer[page >> 3] & (1U << (page & 7)))
+							{
+								const dword offset = page << Baseline::PAGE_SHIFT;
+								stream.Write( data + offset, NST_MIN(length - offset,dword(Baseline::PAGE_SIZE)) );
+							}
+						}
+
+						return *this;
+					}
+				}
+
+				if (compression != NO_COMPRESSION && length > 1)
 				{
-					Vector<byte> buffer( length - 1 );
+					// the work buffer is kept across chunks, only output
+					// smaller than the input is worth storing
+
+					buffer.Resize( length - 1 );
 
-					if (const dword compressed = Zlib::Compress( data, length, buffer.Begin(), buffer.Size(), Zlib::BEST_COMPRESSION ))
+					if (const dword compressed = (compression == ZLIB_COMPRESSION) ? Zlib::Compress( data, length, buffer.Begin(), buffer.Size(), level ) : Lz4::Compress( data, length, buffer.Begin(), buffer.Size() ))
 					{
 						chunks.Back() += 1 + compressed;
-						stream.Write8( ZLIB_COMPRESSION );
+						stream.Write8( compression );
 						stream.Write( buffer.Begin(), compressed );
 						return *this;
 					}
@@ -152,11 +259,11 @@ namespace Nes
 			#pragma optimize("s", on)
 			#endif
 
-			Loader::Loader(StdStream p,bool c)
-			: stream(p), chunks(CHUNK_RESERVE), checkCrc(c)
-			{
-				chunks.SetTo(0);
-			}
+			Loader::Loader(StdStream p,bool c,const Baseline* b)
+			: stream(p), checkCrc(c), baseline(b) {}
+
+			Loader::Loader(const byte* data,dword size,bool c)
+			: stream(data,size), checkCrc(c), baseline(NULL) {}
 
 			Loader::~Loader()
 			{
@@ -183,7 +290,7 @@ namespace Nes
 						throw RESULT_ERR_CORRUPT_FILE;
 				}
 
-				chunks.Append( length );
+				chunks.Push( length );
 
 				return chunk;
 			}
@@ -257,6 +364,30 @@ namespace Nes
 
 				switch (Read8())
 				{
+					case BASELINE_PAGES:
+
+						if (const byte* const base = baseline ? baseline->Block( Read32(), length ) : NULL)
+						{
+							const dword numPages = (length + Baseline::PAGE_SIZE - 1) >> Baseline::PAGE_SHIFT;
+							buffer.Resize( (numPages + 7) >> 3 );
+							Read( buffer.Begin(), buffer.Size() );
+
+							for (dword page=0; page < numPages; ++page)
+							{
+								const dword offset = page << Baseline::PAGE_SHIFT;
+								const dword size = NST_MIN(length - offset,dword(Baseline::PAGE_SIZE));
+
+								if (buffer[page >> 3] & (1U << (page & 7)))
+									Read( data + offset, size );
+								else
+									std::memcpy( data + offset, base + offset, size );
+							}
+
+							break;
+						}
+
+						throw RESULT_ERR_CORRUPT_FILE;
+
 					case NO_COMPRESSION:
 
 						Read( data, length );
@@ -270,13 +401,28 @@ namespace Nes
 						}
 						else if (chunks.Back())
 						{
-							Vector<byte> buffer( chunks.Back() );
+							buffer.Resize( chunks.Back() );
 							Read( buffer.Begin(), buffer.Size() );
 
 							if (Zlib::Uncompress( buffer.Begin(), buffer.Size(), data, length ))
 								break;
 						}
 
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					case FAST_COMPRESSION:
+
+						if (chunks.Back())
+						{
+							buffer.Resize( chunks.Back() );
+							Read( buffer.Begin(), buffer.Size() );
+
+							if (Lz4::Uncompress( buffer.Begin(), buffer.Size(), data, length ) == length)
+								break;
+						}
+
+						throw RESULT_ERR_CORRUPT_FILE;
+
 					default:
 
 						throw RESULT_ERR_CORRUPT_FILE;
@@ -41,11 +41,111 @@ namespace Nes
 	{
 		namespace State
 		{
+			enum Compression
+			{
+				NO_COMPRESSION,
+				ZLIB_COMPRESSION,
+				FAST_COMPRESSION
+			};
+
+			enum
+			{
+				MIN_ZLIB_LEVEL = 1,
+				MAX_ZLIB_LEVEL = 9
+			};
+
+			class Baseline
+			{
+			public:
+
+				Baseline();
+
+				void Reset();
+
+			private:
+
+				friend class Saver;
+				friend class Loader;
+
+				enum
+				{
+					PAGE_SHIFT = 8,
+					PAGE_SIZE = 1U << PAGE_SHIFT
+				};
+
+				void Capture(const byte*,dword);
+				const byte* Block(uint,dword) const;
+				dword Diff(const byte* NST_RESTRICT,dword,uint,byte* NST_RESTRICT) const;
+
+				Vector<byte> data;
+				Vector<dword> blocks;
+
+			public:
+
+				bool Empty() const
+				{
+					return !blocks.Size();
+				}
+			};
+
+			class Chunks
+			{
+			public:
+
+				Chunks()
+				: depth(0) {}
+
+				void Push(dword length)
+				{
+					if (depth == MAX_DEPTH)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					stack[depth++] = length;
+				}
+
+				dword Pop()
+				{
+					NST_ASSERT( depth );
+					return stack[--depth];
+				}
+
+				dword& Back()
+				{
+					NST_ASSERT( depth );
+					return stack[depth-1];
+				}
+
+				dword Back() const
+				{
+					NST_ASSERT( depth );
+					return stack[depth-1];
+				}
+
+				uint Size() const
+				{
+					return depth;
+				}
+
+			private:
+
+				// nesting is shallow, a fixed stack keeps
+				// save and load free of heap traffic
+
+				enum
+				{
+					MAX_DEPTH = 16
+				};
+
+				dword stack[MAX_DEPTH];
+				uint depth;
+			};
+
 			class Saver
 			{
 			public:
 
-				Saver(StdStream,bool,bool,dword=0);
+				Saver(StdStream,Compression,bool,dword=0,uint=MAX_ZLIB_LEVEL,Baseline* =NULL);
+				Saver(byte*,dword,bool);
 				~Saver();
 
 				Saver& Begin(dword);
@@ -63,14 +163,14 @@ namespace Nes
 
 			private:
 
-				enum
-				{
-					CHUNK_RESERVE = 8
-				};
-
-				Vector<dword> chunks;
-				const bool useCompression;
+				Chunks chunks;
+				Vector<byte> buffer;
+				const Compression compression;
+				const uint level;
 				const bool internal;
+				const bool capture;
+				uint block;
+				Baseline* const baseline;
 
 			public:
 
@@ -92,13 +192,40 @@ namespace Nes
 				{
 					return internal;
 				}
+
+				dword Size() const
+				{
+					return stream.Size();
+				}
 			};
 
+			// uncompressed into memory, the buffer is only
+			// grown when the state no longer fits in it
+
+			template<typename T>
+			void SaveFlat(Vector<byte>& buffer,const T& object,void (T::*save)(Saver&) const)
+			{
+				for (;;)
+				{
+					Saver saver( buffer.Begin(), buffer.Capacity(), true );
+					(object.*save)( saver );
+
+					if (saver.Size() <= buffer.Capacity())
+					{
+						buffer.SetTo( saver.Size() );
+						break;
+					}
+
+					buffer.Reserve( saver.Size() );
+				}
+			}
+
 			class Loader
 			{
 			public:
 
-				Loader(StdStream,bool);
+				Loader(StdStream,bool,const Baseline* =NULL);
+				Loader(const byte*,dword,bool);
 				~Loader();
 
 				dword Begin();
@@ -148,13 +275,10 @@ namespace Nes
 
 				void CheckRead(dword);
 
-				enum
-				{
-					CHUNK_RESERVE = 8
-				};
-
-				Vector<dword> chunks;
+				Chunks chunks;
+				Vector<byte> buffer;
 				const bool checkCrc;
+				const Baseline* const baseline;
 
 			public:
 
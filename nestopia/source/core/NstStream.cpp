@@ -22,6 +22,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <iostream>
 #include "NstVector.hpp"
 #include "NstStream.hpp"
@@ -40,16 +41,26 @@ namespace Nes
 					ref.clear();
 			}
 
-			void In::SafeRead(byte* data,dword size)
+			void In::SafeRead(byte* data,dword length)
 			{
-				static_cast<std::istream*>(stream)->read( reinterpret_cast<char*>(data), size );
+				static_cast<std::istream*>(stream)->read( reinterpret_cast<char*>(data), length );
 			}
 
-			void In::Read(byte* data,dword size)
+			void In::Read(byte* data,dword length)
 			{
-				NST_ASSERT( data && size );
+				NST_ASSERT( data && length );
 
-				SafeRead( data, size );
+				if (!stream)
+				{
+					if (size - pos < length)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					std::memcpy( data, memory + pos, length );
+					pos += length;
+					return;
+				}
+
+				SafeRead( data, length );
 
 				if (!*static_cast<std::istream*>(stream))
 					throw RESULT_ERR_CORRUPT_FILE;
@@ -90,6 +101,9 @@ namespace Nes
 
 			uint In::SafeRead8()
 			{
+				if (!stream)
+					return pos < size ? memory[pos++] : ~0U;
+
 				byte data;
 				SafeRead( &data, 1 );
 				return *static_cast<std::istream*>(stream) ? data : ~0U;
@@ -101,6 +115,15 @@ namespace Nes
 
 			void In::Seek(idword distance)
 			{
+				if (!stream)
+				{
+					if (distance < -idword(pos) || distance > idword(size - pos))
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					pos += distance;
+					return;
+				}
+
 				Clear();
 
 				if (!static_cast<std::istream*>(stream)->seekg( distance, std::ios::cur ))
@@ -109,6 +132,9 @@ namespace Nes
 
 			ulong In::Length()
 			{
+				if (!stream)
+					return size - pos;
+
 				Clear();
 
 				std::istream& ref = *static_cast<std::istream*>(stream);
@@ -281,16 +307,31 @@ namespace Nes
 
 			bool In::Eof()
 			{
+				if (!stream)
+					return pos >= size;
+
 				std::istream& ref = *static_cast<std::istream*>(stream);
 				return ref.eof() || (ref.peek(), ref.eof());
 			}
 
-			void Out::Write(const byte* data,dword size)
+			void Out::Write(const byte* data,dword length)
 			{
-				NST_VERIFY( data && size );
+				NST_VERIFY( data && length );
+
+				if (!stream)
+				{
+					if (pos <= capacity && capacity - pos >= length)
+						std::memcpy( memory + pos, data, length );
+
+					pos += length;
 
-				if (!static_cast<std::ostream*>(stream)->write( reinterpret_cast<const char*>(data), size ))
+					if (size < pos)
+						size = pos;
+				}
+				else if (!static_cast<std::ostream*>(stream)->write( reinterpret_cast<const char*>(data), length ))
+				{
 					throw RESULT_ERR_CORRUPT_FILE;
+				}
 			}
 
 			void Out::Write8(const uint data)
@@ -360,6 +401,15 @@ namespace Nes
 
 			void Out::Seek(idword distance)
 			{
+				if (!stream)
+				{
+					if (distance < -idword(pos) || distance > idword(size - pos))
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					pos += distance;
+					return;
+				}
+
 				Clear();
 
 				if (!static_cast<std::ostream*>(stream)->seekp( distance, std::ios::cur ))
@@ -368,6 +418,13 @@ namespace Nes
 
 			bool Out::SeekEnd()
 			{
+				if (!stream)
+				{
+					const bool advanced = (pos != size);
+					pos = size;
+					return advanced;
+				}
+
 				Clear();
 
 				std::ostream& ref = *static_cast<std::ostream*>(stream);
@@ -47,6 +47,9 @@ namespace Nes
 			class In
 			{
 				StdStream const stream;
+				const byte* const memory;
+				const dword size;
+				dword pos;
 
 				void SafeRead(byte*,dword);
 				void Clear();
@@ -54,11 +57,17 @@ namespace Nes
 			public:
 
 				explicit In(StdStream s)
-				: stream(s)
+				: stream(s), memory(NULL), size(0), pos(0)
 				{
 					NST_ASSERT( stream );
 				}
 
+				In(const byte* m,dword n)
+				: stream(NULL), memory(m), size(n), pos(0)
+				{
+					NST_ASSERT( memory || !size );
+				}
+
 				static dword AsciiToC(char* NST_RESTRICT,const byte* NST_RESTRICT,dword);
 
 				void  Read(byte*,dword);
@@ -98,17 +107,32 @@ namespace Nes
 			class Out
 			{
 				StdStream const stream;
+				byte* const memory;
+				const dword capacity;
+				dword pos;
+				dword size;
 
 				void Clear();
 
 			public:
 
 				explicit Out(StdStream s)
-				: stream(s)
+				: stream(s), memory(NULL), capacity(0), pos(0), size(0)
 				{
 					NST_ASSERT( stream );
 				}
 
+				// output past capacity is dropped but still
+				// counted, Size() tells how much room it takes
+
+				Out(byte* m,dword n)
+				: stream(NULL), memory(m), capacity(m ? n : 0), pos(0), size(0) {}
+
+				dword Size() const
+				{
+					return size;
+				}
+
 				void Write(const byte*,dword);
 				void Write8(uint);
 				void Write16(uint);
@@ -147,6 +147,137 @@ namespace Nes
 				count = (count > cpu.GetFrameCycles() ? count - cpu.GetFrameCycles() : 0);
 			}
 
+			// Same interface as M2, for units that can tell how many clocks are left
+			// until they signal (Remaining, 0 if never) and skip clocks that don't
+			// (Advance). Instead of hooking every instruction the unit is caught up
+			// when the board calls Update() and when the IRQ falls due.
+
+			template<typename Unit,uint Divider=1>
+			class LazyM2
+			{
+			public:
+
+				explicit LazyM2(Cpu&);
+
+				template<typename Param>
+				LazyM2(Cpu&,Param&);
+
+				void Reset(bool,bool);
+				void VSync();
+
+			private:
+
+				enum
+				{
+					IRQ_SETUP = 2
+				};
+
+				NES_DECL_HOOK( Signaled );
+
+				void Advance(Cycle);
+
+				Cycle count;
+				ibool connected;
+				Cpu& cpu;
+
+			public:
+
+				Unit unit;
+
+				bool Connect(bool connect)
+				{
+					connected = connect;
+					cpu.ScheduleTimers( cpu.GetCycles() );
+					return connect;
+				}
+
+				bool Connected() const
+				{
+					return connected;
+				}
+
+				void Update()
+				{
+					Advance( cpu.GetCycles() );
+					cpu.ScheduleTimers( cpu.GetCycles() );
+				}
+
+				void ClearIRQ() const
+				{
+					cpu.ClearIRQ();
+				}
+			};
+
+			template<typename Unit,uint Divider>
+			LazyM2<Unit,Divider>::LazyM2(Cpu& c)
+			: count(0), connected(false), cpu(c)
+			{
+			}
+
+			template<typename Unit,uint Divider>
+			template<typename Param>
+			LazyM2<Unit,Divider>::LazyM2(Cpu& c,Param& p)
+			: count(0), connected(false), cpu(c), unit(p)
+			{
+			}
+
+			template<typename Unit,uint Divider>
+			void LazyM2<Unit,Divider>::Reset(const bool hard,const bool connect)
+			{
+				count = 0;
+				connected = connect;
+				unit.Reset( hard );
+				cpu.AddTimer( Hook(this,&LazyM2::Hook_Signaled) );
+			}
+
+			template<typename Unit,uint Divider>
+			void LazyM2<Unit,Divider>::Advance(const Cycle cycle)
+			{
+				if (count > cycle)
+					return;
+
+				const Cycle step = cpu.GetClock(Divider);
+				dword clocks = (cycle - count) / step + 1;
+
+				if (connected)
+				{
+					for (dword next; (next = unit.Remaining()) && next <= clocks; clocks -= next)
+					{
+						unit.Advance( next - 1 );
+						count += (next - 1) * step;
+
+						if (unit.Clock())
+							cpu.DoIRQ( Cpu::IRQ_EXT, count + cpu.GetClock(IRQ_SETUP) );
+
+						count += step;
+					}
+
+					unit.Advance( clocks );
+				}
+
+				count += clocks * step;
+			}
+
+			NES_HOOK_T(template<typename Unit NST_COMMA uint Divider>,LazyM2<Unit NST_COMMA Divider>,Signaled)
+			{
+				NST_COMPILE_ASSERT( Divider <= 8 );
+
+				Advance( cpu.GetCycles() );
+
+				if (connected)
+				{
+					if (const dword next = unit.Remaining())
+						cpu.ScheduleTimers( count + (next - 1) * cpu.GetClock(Divider) );
+				}
+			}
+
+			template<typename Unit,uint Divider>
+			void LazyM2<Unit,Divider>::VSync()
+			{
+				NST_VERIFY( count == 0 || count >= cpu.GetFrameCycles());
+				count = (count > cpu.GetFrameCycles() ? count - cpu.GetFrameCycles() : 0);
+			}
+
 			template<typename Unit,uint Hold,uint Delay>
 			class A12;
 
@@ -216,7 +347,6 @@ namespace Nes
 
 				NES_DECL_LINE( Signaled );
 
-				uint line;
 				Cpu& cpu;
 				Ppu& ppu;
 				Filter<Hold> filter;
@@ -226,7 +356,7 @@ namespace Nes
 				Unit unit;
 
 				A12(Cpu& c,Ppu& p)
-				: line(0), cpu(c), ppu(p) {}
+				: cpu(c), ppu(p) {}
 
 				template<typename Param>
 				A12(Cpu& c,Ppu& p,Param& a)
@@ -234,7 +364,7 @@ namespace Nes
 
 				void Connect(bool connect)
 				{
-					line = ppu.SetAddressLineHook( Io::Line(connect ? this : NULL,connect ? &A12<Unit,Hold,Delay>::Line_Signaled : NULL) ) & 0x1000;
+					ppu.SetAddressLineHook( Io::Line(connect ? this : NULL,connect ? &A12<Unit,Hold,Delay>::Line_Signaled : NULL), Ppu::ADDRESS_LINE_A12 );
 				}
 
 				bool Connected() const
@@ -270,11 +400,10 @@ namespace Nes
 			NES_LINE_T(template<typename Unit NST_COMMA uint Hold NST_COMMA uint Delay>,A12<Unit NST_COMMA Hold NST_COMMA Delay>,Signaled)
 			{
 				NST_COMPILE_ASSERT( Delay <= 8 );
+				NST_ASSERT( address & 0x1000 );
+				static_cast<void>(address);
 
-				uint prev = line;
-				line = address & 0x1000;
-
-				if (line > prev && filter.Clock(cycle) && unit.Clock())
+				if (filter.Clock(cycle) && unit.Clock())
 					cpu.DoIRQ( Cpu::IRQ_EXT, cycle + (Delay ? cpu.GetClock(Delay) : 0) );
 			}
 		}
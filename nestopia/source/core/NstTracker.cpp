@@ -26,8 +26,12 @@
 #include "NstMachine.hpp"
 #include "NstTrackerMovie.hpp"
 #include "NstTrackerRewinder.hpp"
+#include "NstTrackerRunAhead.hpp"
+#include "NstTrackerRollback.hpp"
 #include "NstImage.hpp"
+#include "NstFds.hpp"
 #include "api/NstApiMachine.hpp"
+#include "api/NstApiRewinder.hpp"
 
 namespace Nes
 {
@@ -41,21 +45,32 @@ namespace Nes
 		:
 		frame           (0),
 		rewinderSound   (false),
+		fastLoad        (false),
+		runAheadFrames  (0),
+		rewinderKeys    (Api::Rewinder::DEFAULT_KEYS),
+		rewinderFrames  (Api::Rewinder::DEFAULT_KEY_FRAMES),
+		rewinderMemory  (Api::Rewinder::DEFAULT_MEMORY),
 		rewinderEnabled (NULL),
 		rewinder        (NULL),
-		movie           (NULL)
+		movie           (NULL),
+		runAhead        (NULL),
+		rollback        (NULL)
 		{}
 
 		Tracker::~Tracker()
 		{
 			delete rewinder;
 			delete movie;
+			delete runAhead;
+			delete rollback;
 		}
 
 		void Tracker::Unload()
 		{
 			frame = 0;
 
+			StopRollback();
+
 			if (rewinder)
 				rewinder->Unload();
 			else
@@ -78,6 +93,7 @@ namespace Nes
 
 		void Tracker::PowerOff()
 		{
+			StopRollback();
 			StopMovie();
 		}
 
@@ -122,6 +138,85 @@ namespace Nes
 				rewinder->EnableSound( enable );
 		}
 
+		void Tracker::EnableFastLoad(bool enable)
+		{
+			fastLoad = enable;
+		}
+
+		Result Tracker::SetRunAhead(const uint frames)
+		{
+			if (runAheadFrames == frames)
+				return RESULT_NOP;
+
+			delete runAhead;
+			runAhead = NULL;
+			runAheadFrames = 0;
+
+			if (frames)
+			{
+				runAhead = new RunAhead( frames );
+				runAheadFrames = frames;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Tracker::StartRollback(Machine& emulator,Netplay::Transport& transport,const uint player,const uint players,const uint frames)
+		{
+			if (movie)
+				return RESULT_ERR_NOT_READY;
+
+			Rollback* const instance = new Rollback( emulator, transport, player, players, frames );
+
+			delete rollback;
+			rollback = instance;
+
+			UpdateRewinderState( false );
+
+			return RESULT_OK;
+		}
+
+		void Tracker::StopRollback()
+		{
+			if (rollback)
+			{
+				delete rollback;
+				rollback = NULL;
+
+				UpdateRewinderState( true );
+			}
+		}
+
+		dword Tracker::GetRollbackDesync() const
+		{
+			return rollback ? rollback->GetDesyncFrame() : 0;
+		}
+
+		Result Tracker::SetRewinderHistory(const uint keys,const uint frames,const dword memory)
+		{
+			const bool active = (rewinderEnabled && !movie && !rollback);
+
+			// same settings are only a no-op if a failed allocation
+			// didn't leave the rewinder missing
+
+			if (rewinderKeys == keys && rewinderFrames == frames && rewinderMemory == memory && (rewinder || !active))
+				return RESULT_NOP;
+
+			// the old rewinder must go before the new one hooks the ports
+
+			if (active)
+			{
+				UpdateRewinderState( false );
+				rewinder = CreateRewinder( keys, frames, memory );
+			}
+
+			rewinderKeys = keys;
+			rewinderFrames = frames;
+			rewinderMemory = memory;
+
+			return RESULT_OK;
+		}
+
 		void Tracker::ResetRewinder() const
 		{
 			if (rewinder)
@@ -130,22 +225,10 @@ namespace Nes
 
 		void Tracker::UpdateRewinderState(bool enable)
 		{
-			if (enable && rewinderEnabled && !movie)
+			if (enable && rewinderEnabled && !movie && !rollback)
 			{
 				if (!rewinder)
-				{
-					rewinder = new Rewinder
-					(
-						*rewinderEnabled,
-						&Machine::Execute,
-						&Machine::LoadState,
-						&Machine::SaveState,
-						rewinderEnabled->cpu,
-						rewinderEnabled->cpu.GetApu(),
-						rewinderEnabled->ppu,
-						rewinderSound
-					);
-				}
+					rewinder = CreateRewinder( rewinderKeys, rewinderFrames, rewinderMemory );
 			}
 			else
 			{
@@ -154,9 +237,29 @@ namespace Nes
 			}
 		}
 
+		Tracker::Rewinder* Tracker::CreateRewinder(uint keys,uint frames,dword memory) const
+		{
+			NST_ASSERT( rewinderEnabled );
+
+			return new Rewinder
+			(
+				*rewinderEnabled,
+				&Machine::Execute,
+				&Machine::LoadState,
+				&Machine::SaveState,
+				rewinderEnabled->cpu,
+				rewinderEnabled->cpu.GetApu(),
+				rewinderEnabled->ppu,
+				rewinderSound,
+				keys,
+				frames,
+				memory
+			);
+		}
+
 		Result Tracker::PlayMovie(Machine& emulator,std::istream& stream)
 		{
-			if (!emulator.Is(Api::Machine::GAME))
+			if (!emulator.Is(Api::Machine::GAME) || rollback)
 				return RESULT_ERR_NOT_READY;
 
 			UpdateRewinderState( false );
@@ -209,7 +312,7 @@ namespace Nes
 
 		Result Tracker::RecordMovie(Machine& emulator,std::iostream& stream,const bool append)
 		{
-			if (!emulator.Is(Api::Machine::GAME))
+			if (!emulator.Is(Api::Machine::GAME) || rollback)
 				return RESULT_ERR_NOT_READY;
 
 			UpdateRewinderState( false );
@@ -289,7 +392,7 @@ namespace Nes
 
 		bool Tracker::IsLocked(bool excludeFrame) const
 		{
-			return IsRewinding() || (!excludeFrame && IsMoviePlaying());
+			return IsRewinding() || (!excludeFrame && (IsMoviePlaying() || rollback));
 		}
 
 		bool Tracker::IsActive() const
@@ -313,7 +416,15 @@ namespace Nes
 				{
 					if (machine.Is(Api::Machine::GAME))
 					{
-						if (rewinder)
+						if (rollback)
+						{
+							if (rollback->Execute( video, sound, input ))
+								return RESULT_OK;
+
+							--frame;
+							return RESULT_NOP;
+						}
+						else if (rewinder)
 						{
 							rewinder->Execute( video, sound, input );
 							return RESULT_OK;
@@ -331,7 +442,23 @@ namespace Nes
 						}
 					}
 
-					machine.Execute( video, sound, input );
+					if (fastLoad && !movie && machine.Is(Api::Machine::DISK))
+					{
+						// run through disk access without output, the frame
+						// handed back is the one after the batch
+
+						for (uint i=FAST_LOAD_FRAMES-1; i && static_cast<const Fds*>(machine.image)->IsDriveBusy(); --i)
+						{
+							machine.Execute( NULL, NULL, input );
+							++frame;
+						}
+					}
+
+					if (runAhead && !movie && machine.Is(Api::Machine::GAME))
+						runAhead->Execute( machine, video, sound, input );
+					else
+						machine.Execute( video, sound, input );
+
 					return RESULT_OK;
 				}
 				catch (Result result)
@@ -50,6 +50,11 @@ namespace Nes
 			class Controllers;
 		}
 
+		namespace Netplay
+		{
+			class Transport;
+		}
+
 		class Tracker
 		{
 		public:
@@ -68,11 +73,19 @@ namespace Nes
 
 			Result EnableRewinder(Machine*);
 			void   EnableRewinderSound(bool);
+			Result SetRewinderHistory(uint,uint,dword);
 			void   ResetRewinder() const;
 			Result StartRewinding() const;
 			Result StopRewinding() const;
 			bool   IsRewinding() const;
 
+			void   EnableFastLoad(bool);
+			Result SetRunAhead(uint);
+
+			Result StartRollback(Machine&,Netplay::Transport&,uint,uint,uint);
+			void   StopRollback();
+			dword  GetRollbackDesync() const;
+
 			Result PlayMovie(Machine&,std::istream&);
 			Result RecordMovie(Machine&,std::iostream&,bool);
 			void   StopMovie();
@@ -83,14 +96,30 @@ namespace Nes
 
 			void UpdateRewinderState(bool);
 
+			enum
+			{
+				FAST_LOAD_FRAMES = 32
+			};
+
 			class Movie;
 			class Rewinder;
+			class RunAhead;
+			class Rollback;
+
+			Rewinder* CreateRewinder(uint,uint,dword) const;
 
 			dword frame;
 			ibool rewinderSound;
+			ibool fastLoad;
+			uint runAheadFrames;
+			uint rewinderKeys;
+			uint rewinderFrames;
+			dword rewinderMemory;
 			Machine* rewinderEnabled;
 			Rewinder* rewinder;
 			Movie* movie;
+			RunAhead* runAhead;
+			Rollback* rollback;
 
 		public:
 
@@ -104,6 +133,36 @@ namespace Nes
 				return rewinderSound;
 			}
 
+			uint GetRewinderKeys() const
+			{
+				return rewinderKeys;
+			}
+
+			uint GetRewinderFrames() const
+			{
+				return rewinderFrames;
+			}
+
+			dword GetRewinderMemory() const
+			{
+				return rewinderMemory;
+			}
+
+			bool IsFastLoadEnabled() const
+			{
+				return fastLoad;
+			}
+
+			uint GetRunAhead() const
+			{
+				return runAheadFrames;
+			}
+
+			bool IsRollbackActive() const
+			{
+				return rollback;
+			}
+
 			bool IsFrameLocked() const
 			{
 				return movie;
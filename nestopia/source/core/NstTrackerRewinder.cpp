@@ -24,7 +24,6 @@
 
 #include <cstdlib>
 #include <cstring>
-#include <string>
 #include <algorithm>
 #include "NstMachine.hpp"
 #include "NstState.hpp"
@@ -63,23 +62,28 @@ namespace Nes
 
 			enum
 			{
-				PIXELS    = Video::Screen::PIXELS,
-				SIZE      = PIXELS * dword(NUM_FRAMES),
-				FULL_SIZE = dword(SIZE) + Video::Screen::PIXELS_PADDING
+				PIXELS = Video::Screen::PIXELS
 			};
 
-			Pixel pixels[FULL_SIZE];
+			const uint frames;
+			Pixel* const pixels;
 
 		public:
 
-			Buffer()
+			explicit Buffer(uint f)
+			: frames(f), pixels(new Pixel [PIXELS * dword(f) + Video::Screen::PIXELS_PADDING])
 			{
-				std::fill( pixels + SIZE, pixels + FULL_SIZE, Pixel(0) );
+				std::fill( pixels + PIXELS * dword(f), pixels + PIXELS * dword(f) + Video::Screen::PIXELS_PADDING, Pixel(0) );
+			}
+
+			~Buffer()
+			{
+				delete [] pixels;
 			}
 
 			Pixel* operator [] (dword i)
 			{
-				NST_ASSERT( i < NUM_FRAMES );
+				NST_ASSERT( i < frames );
 				return pixels + (PIXELS * i);
 			}
 		};
@@ -123,15 +127,16 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
-		Tracker::Rewinder::ReverseVideo::ReverseVideo(Ppu& p)
+		Tracker::Rewinder::ReverseVideo::ReverseVideo(Ppu& p,uint f)
 		:
 		pingpong (1),
 		frame    (0),
+		frames   (f),
 		ppu      (p),
 		buffer   (NULL)
 		{}
 
-		Tracker::Rewinder::ReverseSound::ReverseSound(const Apu& a,bool e)
+		Tracker::Rewinder::ReverseSound::ReverseSound(const Apu& a,bool e,uint f)
 		:
 		enabled (e),
 		good    (false),
@@ -139,17 +144,36 @@ namespace Nes
 		bits    (0),
 		rate    (0),
 		index   (0),
+		frames  (f),
 		buffer  (NULL),
 		size    (0),
 		input   (NULL),
 		apu     (a)
 		{}
 
-		Tracker::Rewinder::Rewinder(Machine& e,EmuExecute x,EmuLoadState l,EmuSaveState s,Cpu& c,const Apu& a,Ppu& p,bool b)
+		Tracker::Rewinder::Rewinder
+		(
+			Machine& e,
+			EmuExecute x,
+			EmuLoadState l,
+			EmuSaveState s,
+			Cpu& c,
+			const Apu& a,
+			Ppu& p,
+			bool b,
+			uint k,
+			uint f,
+			dword m
+		)
 		:
 		rewinding    (false),
-		sound        (a,b),
-		video        (p),
+		numKeys      (k),
+		numFrames    (f),
+		history      (m),
+		historyPos   (0),
+		keys         (new Key [k]),
+		sound        (a,b,f),
+		video        (p,f),
 		emulator     (e),
 		emuExecute   (x),
 		emuLoadState (l),
@@ -157,6 +181,8 @@ namespace Nes
 		cpu          (c),
 		ppu          (p)
 		{
+			NST_ASSERT( numKeys >= 2 && numFrames >= 2 && numFrames % 2 == 0 );
+
 			Reset( true );
 		}
 
@@ -173,6 +199,7 @@ namespace Nes
 		Tracker::Rewinder::~Rewinder()
 		{
 			LinkPorts( false );
+			delete [] keys;
 		}
 
 		void Tracker::Rewinder::LinkPorts(bool on)
@@ -191,12 +218,7 @@ namespace Nes
 		}
 
 		Tracker::Rewinder::Key::Key()
-		{
-		}
-
-		Tracker::Rewinder::Key::~Key()
-		{
-		}
+		: offset(0), length(0), size(0) {}
 
 		void Tracker::Rewinder::Key::Input::Reset()
 		{
@@ -206,8 +228,8 @@ namespace Nes
 
 		void Tracker::Rewinder::Key::Reset()
 		{
-			stream.str( std::string() );
 			input.Reset();
+			length = 0;
 		}
 
 		void Tracker::Rewinder::Reset(bool on)
@@ -222,12 +244,16 @@ namespace Nes
 			}
 
 			uturn = false;
-			frame = LAST_FRAME;
-			key = keys + LAST_KEY;
+			frame = numFrames-1;
+			key = keys + (numKeys-1);
+			historyPos = 0;
 
-			for (uint i=0; i < NUM_FRAMES; ++i)
+			for (uint i=0; i < numKeys; ++i)
 				keys[i].Reset();
 
+			state.Destroy();
+			scratch.Destroy();
+
 			LinkPorts( on );
 		}
 
@@ -237,7 +263,7 @@ namespace Nes
 			frame = 0;
 
 			if (buffer == NULL)
-				buffer = new Buffer;
+				buffer = new Buffer( frames );
 		}
 
 		void Tracker::Rewinder::ReverseVideo::End()
@@ -273,7 +299,7 @@ namespace Nes
 			bits = apu.GetSampleBits();
 			rate = apu.GetSampleRate();
 			stereo = apu.InStereo();
-			size = rate << (stereo+1);
+			size = (rate * frames / FRAME_RATE) << (stereo+1);
 
 			const dword total = (bits == 16 ? size * sizeof(iword) : size * sizeof(byte));
 			NST_ASSERT( total );
@@ -428,7 +454,7 @@ namespace Nes
 
 		inline bool Tracker::Rewinder::Key::CanRewind() const
 		{
-			return input.CanRewind();
+			return length && input.CanRewind();
 		}
 
 		inline void Tracker::Rewinder::Key::ResumeForward()
@@ -436,25 +462,9 @@ namespace Nes
 			input.ResumeForward();
 		}
 
-		void Tracker::Rewinder::Key::BeginForward(Machine& emulator,EmuSaveState saveState,EmuLoadState loadState)
+		inline void Tracker::Rewinder::Key::BeginForward()
 		{
-			NST_ASSERT( !saveState || !loadState );
-
 			input.BeginForward();
-
-			if (saveState)
-			{
-				stream.clear();
-				stream.seekp( 0, std::stringstream::beg );
-				stream.clear();
-
-				State::Saver saver( &static_cast<std::ostream&>(stream), false, true );
-				(emulator.*saveState)( saver );
-			}
-			else if (loadState)
-			{
-				TurnForward( emulator, loadState );
-			}
 		}
 
 		void Tracker::Rewinder::Key::EndForward()
@@ -463,21 +473,8 @@ namespace Nes
 				Reset();
 		}
 
-		void Tracker::Rewinder::Key::TurnForward(Machine& emulator,EmuLoadState loadState)
+		inline void Tracker::Rewinder::Key::BeginBackward()
 		{
-			stream.clear();
-			stream.seekg( 0, std::stringstream::beg );
-			stream.clear();
-
-			State::Loader loader( &static_cast<std::istream&>(stream), false );
-			(emulator.*loadState)( loader, true );
-		}
-
-		void Tracker::Rewinder::Key::BeginBackward(Machine& emulator,EmuLoadState loadState)
-		{
-			NST_VERIFY( CanRewind() );
-
-			TurnForward( emulator, loadState );
 			input.BeginBackward();
 		}
 
@@ -498,7 +495,7 @@ namespace Nes
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::PrevKey(Key* k)
 		{
-			return (k != keys ? k-1 : keys+LAST_KEY);
+			return (k != keys ? k-1 : keys+(numKeys-1));
 		}
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::PrevKey()
@@ -508,7 +505,7 @@ namespace Nes
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::NextKey(Key* k)
 		{
-			return (k != keys+LAST_KEY ? k+1 : keys);
+			return (k != keys+(numKeys-1) ? k+1 : keys);
 		}
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::NextKey()
@@ -516,6 +513,187 @@ namespace Nes
 			return NextKey( key );
 		}
 
+		byte* Tracker::Rewinder::PutCount(byte* dst,dword count)
+		{
+			for (; count >= 0x80; count >>= 7)
+				*dst++ = (count & 0x7F) | 0x80;
+
+			*dst++ = count;
+
+			return dst;
+		}
+
+		dword Tracker::Rewinder::GetCount(const byte*& src,const byte* const end)
+		{
+			dword count = 0;
+
+			for (uint shift=0; shift < 32; shift += 7)
+			{
+				if (src == end)
+					break;
+
+				const uint data = *src++;
+				count |= dword(data & 0x7F) << shift;
+
+				if (!(data & 0x80))
+					return count;
+			}
+
+			throw RESULT_ERR_CORRUPT_FILE;
+		}
+
+		dword Tracker::Rewinder::PackDelta(const byte* const NST_RESTRICT a,const byte* const NST_RESTRICT b,const dword length,byte* NST_RESTRICT dst)
+		{
+			// XOR of two states as runs of [unchanged count][changed count][changed bytes],
+			// the unchanged runs being what makes consecutive keys cheap to keep
+
+			const byte* const begin = dst;
+
+			for (dword i=0; i < length; )
+			{
+				const dword same = i;
+
+				while (i < length && a[i] == b[i])
+					++i;
+
+				const dword diff = i;
+
+				while (i < length && a[i] != b[i])
+					++i;
+
+				dst = PutCount( dst, diff - same );
+				dst = PutCount( dst, i - diff );
+
+				for (dword j=diff; j < i; ++j)
+					*dst++ = a[j] ^ b[j];
+			}
+
+			return dst - begin;
+		}
+
+		void Tracker::Rewinder::UnpackDelta(byte* const dst,const dword length,const byte* src,const dword size)
+		{
+			const byte* const end = src + size;
+
+			for (dword i=0; src != end; )
+			{
+				const dword same = GetCount( src, end );
+				const dword diff = GetCount( src, end );
+
+				if (same > length - i || diff > length - i - same || diff > dword(end - src))
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				i += same;
+
+				for (const dword stop = i + diff; i != stop; ++i)
+					dst[i] ^= *src++;
+			}
+		}
+
+		void Tracker::Rewinder::PadState(Vector<byte>& data,const dword length)
+		{
+			const dword size = data.Size();
+
+			if (length > size)
+			{
+				data.Resize( length );
+				std::memset( data.Begin() + size, 0, length - size );
+			}
+		}
+
+		void Tracker::Rewinder::StoreDelta(Key& target,const dword length)
+		{
+			target.length = 0;
+
+			const dword bound = length + length / 2 + length / 64 + 16;
+
+			if (bound > history.Size())
+			{
+				NST_DEBUG_MSG("rewinder memory budget too small!");
+				return;
+			}
+
+			if (historyPos + bound > history.Size())
+				historyPos = 0;
+
+			const dword packed = PackDelta( state.Begin(), scratch.Begin(), length, history.Begin() + historyPos );
+			NST_ASSERT( packed && packed <= bound );
+
+			for (uint i=0; i < numKeys; ++i)
+			{
+				if (keys[i].length && keys[i].offset < historyPos + packed && historyPos < keys[i].offset + keys[i].length)
+					keys[i].length = 0;
+			}
+
+			target.offset = historyPos;
+			target.length = packed;
+
+			historyPos += packed;
+		}
+
+		void Tracker::Rewinder::ApplyDelta(const Key& source,const dword size)
+		{
+			NST_VERIFY( source.length );
+
+			const dword length = NST_MAX(state.Size(),size);
+
+			PadState( state, length );
+			UnpackDelta( state.Begin(), length, history.Begin() + source.offset, source.length );
+			state.SetTo( size );
+		}
+
+		void Tracker::Rewinder::SaveKey()
+		{
+			State::SaveFlat( scratch, emulator, emuSaveState );
+
+			Key& prev = *PrevKey();
+
+			if (state.Size())
+			{
+				const dword size = scratch.Size();
+				const dword length = NST_MAX(state.Size(),size);
+
+				PadState( state, length );
+				PadState( scratch, length );
+				StoreDelta( prev, length );
+				scratch.SetTo( size );
+			}
+			else
+			{
+				prev.length = 0;
+			}
+
+			Vector<byte>::Swap( state, scratch );
+
+			key->size = state.Size();
+			key->length = 0;
+		}
+
+		void Tracker::Rewinder::LoadKey()
+		{
+			State::Loader loader( state.Begin(), state.Size(), false );
+			(emulator.*emuLoadState)( loader, true );
+		}
+
+		void Tracker::Rewinder::StepBackward()
+		{
+			Key* const prev = PrevKey();
+
+			ApplyDelta( *prev, prev->size );
+			key = prev;
+		}
+
+		void Tracker::Rewinder::StepForward()
+		{
+			if (!key->length)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			Key* const next = NextKey();
+
+			ApplyDelta( *key, next->size );
+			key = next;
+		}
+
 		inline void Tracker::Rewinder::ReverseVideo::Flush(const Mutex& mutex)
 		{
 			mutex.Flush( (*buffer)[frame] );
@@ -523,14 +701,14 @@ namespace Nes
 
 		void Tracker::Rewinder::ReverseVideo::Store()
 		{
-			NST_ASSERT( frame < NUM_FRAMES && (pingpong == 1U-0U || pingpong == 0U-1U) );
+			NST_ASSERT( frame < frames && (pingpong == 1U-0U || pingpong == 0U-1U) );
 
 			ppu.SetOutputPixels( (*buffer)[frame] );
 			frame += pingpong;
 
-			if (frame == NUM_FRAMES)
+			if (frame == frames)
 			{
-				frame = LAST_FRAME;
+				frame = frames-1;
 				pingpong = 0U-1U;
 			}
 			else if (frame == 0U-1U)
@@ -543,41 +721,36 @@ namespace Nes
 		template<typename T>
 		NST_FORCE_INLINE Sound::Output* Tracker::Rewinder::ReverseSound::StoreType()
 		{
-			NST_ASSERT( index <= NUM_FRAMES+LAST_FRAME );
-
-			switch (index++)
-			{
-				case 0:
-
-					*output.length = rate / NUM_FRAMES;
-					*output.samples = buffer;
-					input = static_cast<T*>(buffer) + (size / 1);
-					break;
-
-				case LAST_FRAME:
-
-					*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
-					*output.length = dword(static_cast<T*>(buffer) + (size / 2) - static_cast<T*>(*output.samples)) >> stereo;
-					break;
-
-				case NUM_FRAMES:
-
-					*output.length = rate / NUM_FRAMES;
-					*output.samples = static_cast<T*>(buffer) + (size / 2);
-					input = *output.samples;
-					break;
+			NST_ASSERT( index <= frames*2-1 );
 
-				case NUM_FRAMES+LAST_FRAME:
+			const uint i = index++;
 
-					index = 0;
-					*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
-					*output.length = dword(static_cast<T*>(buffer) + (size / 1) - static_cast<T*>(*output.samples)) >> stereo;
-					break;
-
-				default:
-
-					*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
-					break;
+			if (i == 0)
+			{
+				*output.length = rate / FRAME_RATE;
+				*output.samples = buffer;
+				input = static_cast<T*>(buffer) + (size / 1);
+			}
+			else if (i == frames-1)
+			{
+				*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
+				*output.length = dword(static_cast<T*>(buffer) + (size / 2) - static_cast<T*>(*output.samples)) >> stereo;
+			}
+			else if (i == frames)
+			{
+				*output.length = rate / FRAME_RATE;
+				*output.samples = static_cast<T*>(buffer) + (size / 2);
+				input = *output.samples;
+			}
+			else if (i == frames*2-1)
+			{
+				index = 0;
+				*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
+				*output.length = dword(static_cast<T*>(buffer) + (size / 1) - static_cast<T*>(*output.samples)) >> stereo;
+			}
+			else
+			{
+				*output.samples = static_cast<T*>(*output.samples) + (*output.length << stereo);
 			}
 
 			return &output;
@@ -585,8 +758,6 @@ namespace Nes
 
 		Sound::Output* Tracker::Rewinder::ReverseSound::Store()
 		{
-			NST_COMPILE_ASSERT( NUM_FRAMES % 2 == 0 );
-
 			if (!buffer || (bits ^ apu.GetSampleBits()) | (rate ^ apu.GetSampleRate()) | (stereo ^ uint(bool(apu.InStereo()))))
 			{
 				if (!good || !Update() || !enabled)
@@ -653,39 +824,40 @@ namespace Nes
 				if (uturn)
 					ChangeDirection();
 
-				NST_ASSERT( frame < NUM_FRAMES );
+				NST_ASSERT( frame < numFrames );
 
 				if (!rewinding)
 				{
-					if (++frame == NUM_FRAMES)
+					if (++frame == numFrames)
 					{
 						frame = 0;
 						key->EndForward();
 						key = NextKey();
-						key->BeginForward( emulator, emuSaveState, NULL );
+						key->BeginForward();
+						SaveKey();
 					}
 				}
 				else
 				{
-					if (++frame == NUM_FRAMES)
+					if (++frame == numFrames)
 					{
 						frame = 0;
 						key->EndBackward();
 
-						Key* const prev = PrevKey();
-
-						if (prev->CanRewind())
+						if (PrevKey()->CanRewind())
 						{
-							prev->BeginBackward( emulator, emuLoadState );
-							key = prev;
+							StepBackward();
+							LoadKey();
+							key->BeginBackward();
 						}
 						else
 						{
 							rewinding = false;
 
 							key->Invalidate();
-							key = NextKey();
-							key->BeginForward( emulator, NULL, emuLoadState );
+							StepForward();
+							key->BeginForward();
+							LoadKey();
 
 							Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
 
@@ -725,7 +897,7 @@ namespace Nes
 
 			if (rewinding)
 			{
-				for (uint i=frame; i < LAST_FRAME; ++i)
+				for (uint i=frame; i < numFrames-1; ++i)
 					(emulator.*emuExecute)( NULL, NULL, NULL );
 
 				NextKey()->Invalidate();
@@ -733,22 +905,23 @@ namespace Nes
 				video.Begin();
 				sound.Begin();
 
-				key->BeginBackward( emulator, emuLoadState );
+				LoadKey();
+				key->BeginBackward();
 				LinkPorts();
 
 				{
 					const ReverseVideo::Mutex videoMutex( video );
 					const ReverseSound::Mutex soundMutex;
 
-					for (uint i=0; i < NUM_FRAMES; ++i)
+					for (uint i=0; i < numFrames; ++i)
 					{
 						video.Store();
 						(emulator.*emuExecute)( NULL, sound.Store(), NULL );
 					}
 				}
 
-				uint align = LAST_FRAME - frame;
-				frame = LAST_FRAME;
+				uint align = numFrames-1 - frame;
+				frame = numFrames-1;
 
 				while (align--)
 				{
@@ -762,13 +935,13 @@ namespace Nes
 			}
 			else
 			{
-				for (uint i=NUM_FRAMES+LAST_FRAME-frame*2; i; --i)
+				for (uint i=numFrames*2-1-frame*2; i; --i)
 				{
-					if (++frame == NUM_FRAMES)
+					if (++frame == numFrames)
 					{
 						frame = 0;
-						key = NextKey();
-						key->TurnForward( emulator, emuLoadState );
+						StepForward();
+						LoadKey();
 					}
 
 					(emulator.*emuExecute)( NULL, NULL, NULL );
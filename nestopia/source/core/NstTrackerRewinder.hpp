@@ -25,7 +25,6 @@
 #ifndef NST_TRACKER_REWINDER_H
 #define NST_TRACKER_REWINDER_H
 
-#include <sstream>
 #include "api/NstApiSound.hpp"
 
 #ifndef NST_VECTOR_H
@@ -48,7 +47,7 @@ namespace Nes
 
 		public:
 
-			Rewinder(Machine&,EmuExecute,EmuLoadState,EmuSaveState,Cpu&,const Apu&,Ppu&,bool);
+			Rewinder(Machine&,EmuExecute,EmuLoadState,EmuSaveState,Cpu&,const Apu&,Ppu&,bool,uint,uint,dword);
 			~Rewinder();
 
 			Result Start();
@@ -63,10 +62,7 @@ namespace Nes
 
 			enum
 			{
-				NUM_KEYS = 60,
-				LAST_KEY = NUM_KEYS-1,
-				NUM_FRAMES = 60,
-				LAST_FRAME = NUM_FRAMES-1
+				FRAME_RATE = 60
 			};
 
 			class Key
@@ -102,17 +98,15 @@ namespace Nes
 				};
 
 				Input input;
-				std::stringstream stream;
 
 			public:
 
 				Key();
-				~Key();
 
 				void Reset();
-				void BeginForward(Machine&,EmuSaveState,EmuLoadState);
+				inline void BeginForward();
 				void EndForward();
-				void BeginBackward(Machine&,EmuLoadState);
+				inline void BeginBackward();
 				inline void EndBackward();
 
 				inline uint Put(uint);
@@ -120,15 +114,20 @@ namespace Nes
 
 				inline bool CanRewind() const;
 				inline void ResumeForward();
-				inline void TurnForward(Machine&,EmuLoadState);
 				inline void Invalidate();
+
+				// delta against the next key, stored in the history ring
+				dword offset;
+				dword length;
+				// size of this key's uncompressed state
+				dword size;
 			};
 
 			class ReverseVideo
 			{
 			public:
 
-				explicit ReverseVideo(Ppu&);
+				ReverseVideo(Ppu&,uint);
 				~ReverseVideo();
 
 				class Mutex;
@@ -144,6 +143,7 @@ namespace Nes
 
 				uint pingpong;
 				uint frame;
+				const uint frames;
 				Ppu& ppu;
 				Buffer* buffer;
 			};
@@ -154,7 +154,7 @@ namespace Nes
 
 				typedef Sound::Output Output;
 
-				ReverseSound(const Apu&,bool);
+				ReverseSound(const Apu&,bool,uint);
 				~ReverseSound();
 
 				class Mutex;
@@ -184,6 +184,7 @@ namespace Nes
 				byte bits;
 				dword rate;
 				uint index;
+				const uint frames;
 				void* buffer;
 				dword size;
 				Output output;
@@ -203,6 +204,19 @@ namespace Nes
 			inline Key* NextKey(Key*);
 			inline Key* NextKey();
 
+			void SaveKey();
+			void LoadKey();
+			void StepBackward();
+			void StepForward();
+			void StoreDelta(Key&,dword);
+			void ApplyDelta(const Key&,dword);
+
+			static void  PadState(Vector<byte>&,dword);
+			static dword PackDelta(const byte* NST_RESTRICT,const byte* NST_RESTRICT,dword,byte* NST_RESTRICT);
+			static void  UnpackDelta(byte*,dword,const byte*,dword);
+			static byte* PutCount(byte*,dword);
+			static dword GetCount(const byte*&,const byte*);
+
 			NES_DECL_PEEK( Port_Get );
 			NES_DECL_PEEK( Port_Put );
 			NES_DECL_POKE( Port     );
@@ -211,10 +225,18 @@ namespace Nes
 			ibool uturn;
 			uint frame;
 
+			const uint numKeys;
+			const uint numFrames;
+
 			const Io::Port* ports[2];
 
+			Vector<byte> history;
+			dword historyPos;
+			Vector<byte> state;
+			Vector<byte> scratch;
+
 			Key* key;
-			Key keys[NUM_KEYS];
+			Key* const keys;
 
 			ReverseSound sound;
 			ReverseVideo video;
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstring>
+#include "NstMachine.hpp"
+#include "NstState.hpp"
+#include "NstTrackerRollback.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Tracker::Rollback::Rollback(Machine& m,Netplay::Transport& t,const uint p,const uint n,const uint f)
+		:
+		machine   (m),
+		transport (t),
+		player    (p),
+		players   (n),
+		frames    (f),
+		frame     (0),
+		hashFrame (0),
+		hash      (0),
+		desync    (0),
+		snapshots (new Vector<byte> [f+1])
+		{
+			NST_ASSERT( player < players && players <= Input::NUM_PADS && frames && frames <= Api::Netplay::MAX_FRAMES );
+
+			std::memset( confirmed, 0, sizeof(confirmed) );
+			std::memset( inputs, 0, sizeof(inputs) );
+			std::memset( local, 0, sizeof(local) );
+			std::memset( remote, 0, sizeof(remote) );
+		}
+
+		Tracker::Rollback::~Rollback()
+		{
+			delete [] snapshots;
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+
+		void Tracker::Rollback::Save(const dword index)
+		{
+			State::SaveFlat( snapshots[index % (frames+1)], machine, &Machine::SaveState );
+		}
+
+		void Tracker::Rollback::Load(const dword index)
+		{
+			const Vector<byte>& snapshot = snapshots[index % (frames+1)];
+
+			State::Loader loader( snapshot.Begin(), snapshot.Size(), false );
+			machine.LoadState( loader, true );
+		}
+
+		dword Tracker::Rollback::Hash(const dword index)
+		{
+			const Vector<byte>& snapshot = snapshots[index % (frames+1)];
+
+			dword value = 0x811C9DC5;
+
+			for (const byte *it=snapshot.Begin(), *const end=snapshot.End(); it != end; ++it)
+				value = ((value ^ *it) * 0x01000193) & 0xFFFFFFFF;
+
+			return value;
+		}
+
+		void Tracker::Rollback::Compare(const dword index,const dword a,const dword b)
+		{
+			if (a != b && (!desync || desync > index))
+				desync = index;
+		}
+
+		void Tracker::Rollback::Run(const dword index,Video::Output* const video,Sound::Output* const sound)
+		{
+			byte (&buttons)[Input::NUM_PADS] = inputs[index % INPUT_FRAMES];
+
+			for (uint i=0; i < players; ++i)
+			{
+				// remote input not in yet is assumed to be
+				// held the same as the last one received
+
+				if (index >= confirmed[i])
+					buttons[i] = confirmed[i] ? inputs[(confirmed[i]-1) % INPUT_FRAMES][i] : 0;
+
+				controllers.pad[i].buttons = buttons[i];
+			}
+
+			machine.Execute( video, sound, &controllers );
+		}
+
+		bool Tracker::Rollback::Execute
+		(
+			Video::Output* const video,
+			Sound::Output* const sound,
+			Input::Controllers* const input
+		)
+		{
+			uint buttons = 0;
+
+			if (input && Input::Controllers::Pad::callback( input->pad[player], player ))
+				buttons = input->pad[player].buttons & 0xFF;
+
+			dword resync = frame;
+			dword oldest = frame + 1;
+
+			for (Netplay::Packet packet; transport.Receive( packet ); )
+			{
+				const uint i = packet.player;
+
+				NST_VERIFY( i < players && i != player );
+
+				if (i >= players || i == player)
+					continue;
+
+				if (packet.frame == confirmed[i])
+				{
+					byte& slot = inputs[packet.frame % INPUT_FRAMES][i];
+
+					if (packet.frame < frame && slot != (packet.buttons & 0xFF))
+						resync = NST_MIN(resync,dword(packet.frame));
+
+					slot = packet.buttons & 0xFF;
+					++confirmed[i];
+				}
+
+				if (packet.hashFrame)
+				{
+					Check& check = remote[i][packet.hashFrame % HASH_FRAMES];
+					check.frame = packet.hashFrame;
+					check.hash = packet.hash;
+
+					if (local[packet.hashFrame % HASH_FRAMES].frame == packet.hashFrame)
+						Compare( packet.hashFrame, local[packet.hashFrame % HASH_FRAMES].hash, packet.hash );
+				}
+			}
+
+			for (uint i=0; i < players; ++i)
+			{
+				if (i != player && oldest > confirmed[i])
+					oldest = confirmed[i];
+			}
+
+			// the game sees only what the session feeds it
+
+			Input::Controllers::Pad::PollCallback function;
+			void* data;
+
+			Input::Controllers::Pad::callback.Get( function, data );
+			Input::Controllers::Pad::callback.Unset();
+
+			try
+			{
+				if (resync < frame)
+				{
+					Load( resync );
+
+					for (dword i=resync; i < frame; ++i)
+					{
+						if (i != resync)
+							Save( i );
+
+						Run( i, NULL, NULL );
+					}
+				}
+
+				if (frame >= oldest + frames)
+				{
+					Input::Controllers::Pad::callback.Set( function, data );
+					return false;
+				}
+
+				inputs[frame % INPUT_FRAMES][player] = buttons;
+				confirmed[player] = frame + 1;
+
+				Save( frame );
+
+				// the state at the start of the oldest frame still
+				// missing remote input won't be run again
+
+				if (hashFrame < NST_MIN(oldest,frame))
+				{
+					hashFrame = NST_MIN(oldest,frame);
+					hash = Hash( hashFrame );
+
+					Check& check = local[hashFrame % HASH_FRAMES];
+					check.frame = hashFrame;
+					check.hash = hash;
+
+					for (uint i=0; i < players; ++i)
+					{
+						if (remote[i][hashFrame % HASH_FRAMES].frame == hashFrame)
+							Compare( hashFrame, hash, remote[i][hashFrame % HASH_FRAMES].hash );
+					}
+				}
+
+				Netplay::Packet packet;
+
+				packet.frame = frame;
+				packet.player = player;
+				packet.buttons = buttons;
+				packet.hashFrame = hashFrame;
+				packet.hash = hash;
+
+				transport.Send( packet );
+
+				Run( frame++, video, sound );
+			}
+			catch (...)
+			{
+				Input::Controllers::Pad::callback.Set( function, data );
+				throw;
+			}
+
+			Input::Controllers::Pad::callback.Set( function, data );
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef NST_TRACKER_ROLLBACK_H
+#define NST_TRACKER_ROLLBACK_H
+
+#include "api/NstApiInput.hpp"
+#include "api/NstApiNetplay.hpp"
+
+#ifndef NST_VECTOR_H
+#include "NstVector.hpp"
+#endif
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace Nes
+{
+	namespace Core
+	{
+		class Tracker::Rollback
+		{
+		public:
+
+			Rollback(Machine&,Netplay::Transport&,uint,uint,uint);
+			~Rollback();
+
+			bool Execute(Video::Output*,Sound::Output*,Input::Controllers*);
+
+		private:
+
+			void Save(dword);
+			void Load(dword);
+			void Run(dword,Video::Output*,Sound::Output*);
+			dword Hash(dword);
+			void Compare(dword,dword,dword);
+
+			enum
+			{
+				INPUT_FRAMES = 64,
+				HASH_FRAMES = 64
+			};
+
+			NST_COMPILE_ASSERT( INPUT_FRAMES > Api::Netplay::MAX_FRAMES * 2 + 1 );
+
+			struct Check
+			{
+				dword frame;
+				dword hash;
+			};
+
+			Machine& machine;
+			Netplay::Transport& transport;
+			const uint player;
+			const uint players;
+			const uint frames;
+			dword frame;
+			dword hashFrame;
+			dword hash;
+			dword desync;
+			Vector<byte>* const snapshots;
+			dword confirmed[Input::NUM_PADS];
+			byte inputs[INPUT_FRAMES][Input::NUM_PADS];
+			Check local[HASH_FRAMES];
+			Check remote[Input::NUM_PADS][HASH_FRAMES];
+			Input::Controllers controllers;
+
+		public:
+
+			dword GetDesyncFrame() const
+			{
+				return desync;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NstMachine.hpp"
+#include "NstState.hpp"
+#include "NstTrackerRunAhead.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Tracker::RunAhead::RunAhead(const uint f)
+		:
+		frames ( f )
+		{
+			NST_ASSERT( frames );
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+
+		void Tracker::RunAhead::Execute
+		(
+			Machine& machine,
+			Video::Output* const video,
+			Sound::Output* const sound,
+			Input::Controllers* const input
+		)
+		{
+			// the real frame is heard but never seen, what's shown is a
+			// frame further ahead run on the same input and then undone
+
+			machine.Execute( NULL, sound, input );
+
+			State::SaveFlat( state, machine, &Machine::SaveState );
+
+			for (uint i=frames; --i; )
+				machine.Execute( NULL, NULL, input );
+
+			machine.Execute( video, NULL, input );
+
+			State::Loader loader( state.Begin(), state.Size(), false );
+			machine.LoadState( loader, true );
+		}
+	}
+}
@@ -27,6 +27,8 @@
 #include <cerrno>
 #include <cstring>
 #include <iostream>
+#include <algorithm>
+#include <new>
 #include "NstStream.hpp"
 #include "NstVector.hpp"
 #include "NstXml.hpp"
@@ -49,8 +51,8 @@ namespace Nes
 
 		void Xml::Destroy()
 		{
-			delete root;
 			root = NULL;
+			arena.Clear();
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
@@ -103,7 +105,7 @@ namespace Nes
 		}
 
 		Xml::Input::Input(std::istream& s,dword t)
-		: stream(Init(s,t)), size(t), pos(0) {}
+		: stream(Init(s,t)), size(t) {}
 
 		Xml::Input::~Input()
 		{
@@ -115,6 +117,12 @@ namespace Nes
 			return size;
 		}
 
+		inline const byte* Xml::Input::Data(dword i) const
+		{
+			NST_ASSERT( i <= size );
+			return stream + i;
+		}
+
 		inline uint Xml::Input::ToByte(dword i) const
 		{
 			NST_ASSERT( i < size+4 );
@@ -137,53 +145,91 @@ namespace Nes
 			return ToByte(i+0) | ToByte(i+1) << 8;
 		}
 
-		inline void Xml::Input::SetReadPointer(dword p)
+		Xml::Arena::Arena()
+		: blocks(NULL), pos(NULL), end(NULL) {}
+
+		Xml::Arena::~Arena()
 		{
-			NST_ASSERT( p <= size );
-			pos = p;
+			Clear();
 		}
 
-		uint Xml::Input::ReadUTF8()
+		void Xml::Arena::Clear()
 		{
-			NST_ASSERT( pos <= size );
+			while (Block* const block = blocks)
+			{
+				blocks = block->next;
+				std::free( block );
+			}
+
+			pos = NULL;
+			end = NULL;
+		}
 
-			if (uint v = ToByte(pos))
+		void* Xml::Arena::Alloc(dword size)
+		{
+			enum
 			{
-				pos++;
+				HEADER = (sizeof(Block) + (ALIGNMENT-1)) & ~uint(ALIGNMENT-1)
+			};
 
-				if (v & 0x80)
-				{
-					const uint w = ToByte(pos++);
+			size = (size + (ALIGNMENT-1)) & ~dword(ALIGNMENT-1);
 
-					if ((v & 0xE0) == 0xC0)
-					{
-						if ((w & 0xC0) != 0x80)
-							throw 1;
+			if (dword(end - pos) >= size)
+			{
+				void* const data = pos;
+				pos += size;
+				return data;
+			}
 
-						v = (v << 6 & 0x7C0) | (w & 0x03F);
-					}
-					else if ((v & 0xF0) == 0xE0)
-					{
-						const uint z = ToByte(pos++);
+			const bool large = (size > BLOCK_SIZE / 4);
+			Block* const block = static_cast<Block*>(std::malloc( HEADER + (large ? size : dword(BLOCK_SIZE)) ));
 
-						if ((w & 0xC0) == 0x80)
-						{
-							if ((z & 0xC0) != 0x80)
-								throw 1;
+			if (!block)
+				throw std::bad_alloc();
 
-							v = (v << 12 & 0xF000) | (w << 6 & 0x0FC0) | (z & 0x03F);
-						}
-					}
-					else
-					{
-						throw 1;
-					}
-				}
+			byte* const data = reinterpret_cast<byte*>(block) + HEADER;
 
-				return v;
+			if (large && blocks)
+			{
+				// keep filling the current block
+
+				block->next = blocks->next;
+				blocks->next = block;
 			}
+			else
+			{
+				block->next = blocks;
+				blocks = block;
+
+				pos = data + size;
+				end = data + (large ? size : dword(BLOCK_SIZE));
+			}
+
+			return data;
+		}
 
-			return 0;
+		wchar_t* Xml::Arena::Copy(wcstring const begin,wcstring const end)
+		{
+			wchar_t* const string = static_cast<wchar_t*>(Alloc( (end - begin + 1) * sizeof(wchar_t) ));
+
+			std::copy( begin, end, string );
+			string[end - begin] = L'\0';
+
+			return string;
+		}
+
+		Xml::BaseNode* Xml::BaseNode::Create(Arena& arena,wcstring const type)
+		{
+			BaseNode* const node = static_cast<BaseNode*>(arena.Alloc( sizeof(BaseNode) ));
+
+			node->type = type;
+			node->value = L"";
+			node->attribute = NULL;
+			node->child = NULL;
+			node->sibling = NULL;
+			node->arena = &arena;
+
+			return node;
 		}
 
 		Xml::Output::Output(std::ostream& s,const Format& f)
@@ -298,39 +344,184 @@ namespace Nes
 			return *this;
 		}
 
+		struct Xml::Utf16
+		{
+			typedef utfchar Unit;
+
+			static uint Decode(const Unit*& src)
+			{
+				return *src++;
+			}
+		};
+
+		struct Xml::Latin1
+		{
+			typedef byte Unit;
+
+			static uint Decode(const Unit*& src)
+			{
+				return *src++;
+			}
+		};
+
+		struct Xml::Utf8
+		{
+			typedef byte Unit;
+
+			static uint Decode(const Unit*& src)
+			{
+				uint v = *src++;
+
+				if (v & 0x80)
+				{
+					const uint w = *src++;
+
+					if ((w & 0xC0) != 0x80)
+						throw 1;
+
+					if ((v & 0xE0) == 0xC0)
+					{
+						v = (v << 6 & 0x7C0) | (w & 0x03F);
+					}
+					else if ((v & 0xF0) == 0xE0)
+					{
+						const uint z = *src++;
+
+						if ((z & 0xC0) != 0x80)
+							throw 1;
+
+						v = (v << 12 & 0xF000) | (w << 6 & 0x0FC0) | (z & 0x03F);
+					}
+					else
+					{
+						throw 1;
+					}
+				}
+
+				return v;
+			}
+		};
+
+		template<typename Encoding>
+		class Xml::Parser
+		{
+			typedef typename Encoding::Unit Unit;
+			typedef const Unit* Stream;
+
+			enum
+			{
+				NUM_NAMES = 256
+			};
+
+			struct Name
+			{
+				Stream string;
+				dword length;
+				wcstring type;
+			};
+
+			static Tag CheckTag(Stream);
+			static Stream SkipVoid(Stream);
+			static Stream RewindVoid(Stream,Stream=NULL);
+			static uint ParseReference(Stream&,Stream);
+
+			wcstring SetType(Stream,Stream);
+			wcstring SetValue(Stream,Stream);
+			Stream ReadTag(Stream,BaseNode*&);
+			Stream ReadValue(Stream,BaseNode&);
+			Stream ReadNode(Stream,Tag,BaseNode*&);
+
+			Arena& arena;
+			Name names[NUM_NAMES];
+
+		public:
+
+			explicit Parser(Arena&);
+
+			BaseNode* Parse(Stream);
+		};
+
+		template<typename Encoding>
+		Xml::Parser<Encoding>::Parser(Arena& a)
+		: arena(a)
+		{
+			for (uint i=0; i < NUM_NAMES; ++i)
+				names[i].type = NULL;
+		}
+
+		template<typename Encoding>
+		Xml::BaseNode* Xml::Parser<Encoding>::Parse(Stream const file)
+		{
+			BaseNode* root = NULL;
+
+			for (Stream stream = SkipVoid( file ); *stream; )
+			{
+				switch (const Tag tag = CheckTag( stream ))
+				{
+					case TAG_XML:
+
+						if (stream != file)
+							throw 1;
+
+					case TAG_COMMENT:
+					case TAG_INSTRUCTION:
+
+						stream = ReadTag( stream, root );
+						break;
+
+					case TAG_OPEN:
+					case TAG_OPEN_CLOSE:
+
+						if (!root)
+						{
+							stream = ReadNode( stream, tag, root );
+							break;
+						}
+
+					default:
+
+						throw 1;
+				}
+			}
+
+			return root;
+		}
+
 		Xml::Node Xml::Read(std::istream& stream)
 		{
 			Destroy();
 
-			Vector<utfchar> buffer;
-
 			try
 			{
 				Input input( stream );
 
 				if (input.ToByte(0) == 0xFE && input.ToByte(1) == 0xFF)
 				{
-					buffer.Resize( input.Size() / 2 );
+					Vector<utfchar> buffer( input.Size() / 2 );
 
 					for (dword i=0, n=buffer.Size(); i < n; ++i)
 						buffer[i] = input.FromUTF16BE( 2 + i * 2 );
+
+					root = Parser<Utf16>( arena ).Parse( buffer.Begin() );
 				}
 				else if (input.ToByte(0) == 0xFF && input.ToByte(1) == 0xFE)
 				{
-					buffer.Resize( input.Size() / 2 );
+					Vector<utfchar> buffer( input.Size() / 2 );
 
 					for (dword i=0, n=buffer.Size(); i < n; ++i)
 						buffer[i] = input.FromUTF16LE( 2 + i * 2 );
+
+					root = Parser<Utf16>( arena ).Parse( buffer.Begin() );
 				}
 				else
 				{
-					bool utf8 = (input.ToByte(0) == 0xEF && input.ToByte(1) == 0xBB && input.ToByte(2) == 0xBF);
+					// 8-bit input is parsed where it lies, characters are
+					// only decoded when copied out into names and values
 
-					if (utf8)
-					{
-						input.SetReadPointer(3);
-					}
-					else if (input.ToChar(0) == '<' && input.ToChar(1) == '?')
+					const bool bom = (input.ToByte(0) == 0xEF && input.ToByte(1) == 0xBB && input.ToByte(2) == 0xBF);
+					bool utf8 = bom;
+
+					if (!utf8 && input.ToChar(0) == '<' && input.ToChar(1) == '?')
 					{
 						for (uint i=2; i < 128 && input.ToChar(i) && input.ToChar(i) != '>'; ++i)
 						{
@@ -349,34 +540,17 @@ namespace Nes
 					}
 
 					if (utf8)
-					{
-						buffer.Reserve( input.Size() );
-
-						uint v;
-
-						do
-						{
-							v = input.ReadUTF8();
-							buffer.Append( v );
-						}
-						while (v);
-					}
+						root = Parser<Utf8>( arena ).Parse( input.Data(bom ? 3 : 0) );
 					else
-					{
-						buffer.Resize( input.Size() + 1 );
-
-						for (dword i=0, n=buffer.Size(); i < n; ++i)
-							buffer[i] = input.ToByte( i );
-					}
+						root = Parser<Latin1>( arena ).Parse( input.Data(0) );
 				}
 			}
 			catch (...)
 			{
 				Destroy();
-				return NULL;
 			}
 
-			return Read( buffer.Begin() );
+			return root;
 		}
 
 		Xml::Node Xml::Create(wcstring type)
@@ -387,7 +561,7 @@ namespace Nes
 			{
 				try
 				{
-					root = new BaseNode( type, type + std::wcslen(type), BaseNode::OUT );
+					root = BaseNode::Create( arena, arena.Copy( type, type + std::wcslen(type) ) );
 				}
 				catch (...)
 				{
@@ -406,35 +580,7 @@ namespace Nes
 			{
 				try
 				{
-					for (utfstring stream = SkipVoid( file ); *stream; )
-					{
-						switch (const Tag tag = CheckTag( stream ))
-						{
-							case TAG_XML:
-
-								if (stream != file)
-									throw 1;
-
-							case TAG_COMMENT:
-							case TAG_INSTRUCTION:
-
-								stream = ReadTag( stream, root );
-								break;
-
-							case TAG_OPEN:
-							case TAG_OPEN_CLOSE:
-
-								if (!root)
-								{
-									stream = ReadNode( stream, tag, root );
-									break;
-								}
-
-							default:
-
-								throw 1;
-						}
-					}
+					root = Parser<Utf16>( arena ).Parse( file );
 				}
 				catch (...)
 				{
@@ -509,7 +655,8 @@ namespace Nes
 			output << output.format.newline;
 		}
 
-		Xml::utfstring Xml::ReadNode(utfstring stream,Tag tag,BaseNode*& node)
+		template<typename Encoding>
+		typename Xml::Parser<Encoding>::Stream Xml::Parser<Encoding>::ReadNode(Stream stream,Tag tag,BaseNode*& node)
 		{
 			NST_ASSERT( node == NULL && tag != TAG_CLOSE );
 
@@ -543,7 +690,8 @@ namespace Nes
 			return stream;
 		}
 
-		Xml::utfstring Xml::ReadTag(utfstring stream,BaseNode*& node)
+		template<typename Encoding>
+		typename Xml::Parser<Encoding>::Stream Xml::Parser<Encoding>::ReadTag(Stream stream,BaseNode*& node)
 		{
 			NST_ASSERT( *stream == '<' );
 
@@ -579,9 +727,11 @@ namespace Nes
 				if (*stream++ != '/')
 					throw 1;
 
-				for (wcstring type=node->type; *stream; ++stream, ++type)
+				for (wcstring type=node->type; *stream; ++type)
 				{
-					if (ToWideChar(*stream) != *type)
+					Stream next = stream;
+
+					if (ToWideChar( Encoding::Decode( next ) ) != *type)
 					{
 						if (*type)
 							throw 1;
@@ -589,20 +739,25 @@ namespace Nes
 						stream = SkipVoid( stream );
 						break;
 					}
+
+					stream = next;
 				}
 			}
 			else
 			{
-				for (utfstring const t=stream; *stream; ++stream)
+				for (Stream const t=stream; *stream; ++stream)
 				{
 					if (*stream == '>' || *stream == '/' || IsVoid( *stream ))
 					{
-						node = new BaseNode( t, stream, BaseNode::IN );
+						node = BaseNode::Create( arena, SetType( t, stream ) );
 						break;
 					}
 				}
 
-				for (;;++stream)
+				if (!node)
+					throw 1;
+
+				for (BaseNode::Attribute** next = &node->attribute;;++stream)
 				{
 					if (*stream == '>')
 					{
@@ -615,12 +770,12 @@ namespace Nes
 					}
 					else if (!IsVoid( *stream ))
 					{
-						utfstring const t = stream;
+						Stream const t = stream;
 
 						while (*stream && *stream != '=' && !IsVoid( *stream ))
 							++stream;
 
-						utfstring const tn = stream;
+						Stream const tn = stream;
 
 						stream = SkipVoid( stream );
 
@@ -629,22 +784,29 @@ namespace Nes
 
 						stream = SkipVoid( stream );
 
-						const utfchar enclosing = *stream++;
+						const uint enclosing = *stream++;
 
 						if (enclosing != '\"' && enclosing != '\'')
 							throw 1;
 
 						stream = SkipVoid( stream );
 
-						utfstring const v = stream;
+						Stream const v = stream;
 
 						while (*stream && *stream != enclosing)
 							++stream;
 
-						if (*stream != enclosing)
+						if (*stream != enclosing || t == tn)
 							throw 1;
 
-						node->AddAttribute( t, tn, v, RewindVoid(stream,v) );
+						BaseNode::Attribute* const attribute = static_cast<BaseNode::Attribute*>(arena.Alloc( sizeof(BaseNode::Attribute) ));
+
+						attribute->type = SetType( t, tn );
+						attribute->value = SetValue( v, RewindVoid(stream,v) );
+						attribute->next = NULL;
+
+						*next = attribute;
+						next = &attribute->next;
 					}
 				}
 			}
@@ -655,15 +817,25 @@ namespace Nes
 			return SkipVoid( stream );
 		}
 
-		Xml::utfstring Xml::ReadValue(utfstring stream,BaseNode& node)
+		template<typename Encoding>
+		typename Xml::Parser<Encoding>::Stream Xml::Parser<Encoding>::ReadValue(Stream stream,BaseNode& node)
 		{
 			NST_ASSERT( *stream != '<' && !IsVoid( *stream ) );
 
-			for (utfstring const value = stream; *stream; ++stream)
+			for (Stream const value = stream; *stream; ++stream)
 			{
 				if (*stream == '<')
 				{
-					node.SetValue( value, RewindVoid(stream), BaseNode::IN );
+					Stream const end = RewindVoid( stream );
+
+					if (end != value)
+					{
+						if (*node.value)
+							throw 1;
+
+						node.value = SetValue( value, end );
+					}
+
 					break;
 				}
 			}
@@ -671,6 +843,71 @@ namespace Nes
 			return stream;
 		}
 
+		template<typename Encoding>
+		wcstring Xml::Parser<Encoding>::SetType(Stream const src,Stream const end)
+		{
+			// element and attribute names repeat all over a document,
+			// so each distinct spelling is only converted once
+
+			dword hash = end - src;
+
+			for (Stream it=src; it != end; ++it)
+				hash = hash * 31 + *it;
+
+			Name& name = names[hash % NUM_NAMES];
+
+			if (name.type && name.length == dword(end - src) && std::equal( src, end, name.string ))
+				return name.type;
+
+			wchar_t* const type = static_cast<wchar_t*>(arena.Alloc( (end - src + 1) * sizeof(wchar_t) ));
+			wchar_t* dst = type;
+
+			for (Stream it=src; it != end; )
+			{
+				const uint ch = Encoding::Decode( it );
+
+				if (IsCtrl( ch ))
+					throw 1;
+
+				*dst++ = ToWideChar( ch );
+			}
+
+			*dst = L'\0';
+
+			name.string = src;
+			name.length = end - src;
+			name.type = type;
+
+			return type;
+		}
+
+		template<typename Encoding>
+		wcstring Xml::Parser<Encoding>::SetValue(Stream src,Stream const end)
+		{
+			if (src == end)
+				return L"";
+
+			wchar_t* const value = static_cast<wchar_t*>(arena.Alloc( (end - src + 1) * sizeof(wchar_t) ));
+			wchar_t* dst = value;
+
+			while (src != end)
+			{
+				uint ch = Encoding::Decode( src );
+
+				if (ch == '&')
+					ch = ParseReference( src, end );
+
+				if (IsCtrl( ch ) && !IsVoid( ch ))
+					throw 1;
+
+				*dst++ = ToWideChar( ch );
+			}
+
+			*dst = L'\0';
+
+			return value;
+		}
+
 		bool Xml::IsEqual(wcstring a,wcstring b)
 		{
 			do
@@ -741,7 +978,7 @@ namespace Nes
 			return value;
 		}
 
-		bool Xml::IsVoid(utfchar ch)
+		bool Xml::IsVoid(uint ch)
 		{
 			switch (ch)
 			{
@@ -756,7 +993,7 @@ namespace Nes
 			return false;
 		}
 
-		bool Xml::IsCtrl(utfchar ch)
+		bool Xml::IsCtrl(uint ch)
 		{
 			switch (ch)
 			{
@@ -775,7 +1012,8 @@ namespace Nes
 			return false;
 		}
 
-		Xml::utfstring Xml::SkipVoid(utfstring stream)
+		template<typename Encoding>
+		typename Xml::Parser<Encoding>::Stream Xml::Parser<Encoding>::SkipVoid(Stream stream)
 		{
 			while (IsVoid( *stream ))
 				++stream;
@@ -783,7 +1021,8 @@ namespace Nes
 			return stream;
 		}
 
-		Xml::utfstring Xml::RewindVoid(utfstring stream,utfstring stop)
+		template<typename Encoding>
+		typename Xml::Parser<Encoding>::Stream Xml::Parser<Encoding>::RewindVoid(Stream stream,Stream stop)
 		{
 			while (stream != stop && IsVoid( stream[-1] ))
 				--stream;
@@ -791,7 +1030,8 @@ namespace Nes
 			return stream;
 		}
 
-		Xml::Tag Xml::CheckTag(utfstring stream)
+		template<typename Encoding>
+		Xml::Tag Xml::Parser<Encoding>::CheckTag(Stream stream)
 		{
 			if (stream[0] == '<')
 			{
@@ -824,7 +1064,7 @@ namespace Nes
 				{
 					if (*stream == '\"' || *stream == '\'')
 					{
-						for (const utfchar enclosing = *stream; stream[1]; )
+						for (const uint enclosing = *stream; stream[1]; )
 						{
 							if (*++stream == enclosing)
 								break;
@@ -843,172 +1083,10 @@ namespace Nes
 			throw 1;
 		}
 
-		template<typename T,typename U>
-		Xml::BaseNode::BaseNode(T t,T n,U u)
-		:
-		type      (SetType(new wchar_t [n-t+1],t,n,u)),
-		value     (L""),
-		attribute (NULL),
-		child     (NULL),
-		sibling   (NULL)
-		{
-			if (!type)
-				throw 1;
-		}
-
-		template<typename T,typename U>
-		Xml::BaseNode::Attribute::Attribute(T t,T tn,T v,T vn,U u)
-		:
-		type  (SetType(new wchar_t [(tn-t)+1+(vn-v)+1],t,tn,u)),
-		value (SetValue(const_cast<wchar_t*>(type+(tn-t)+1),v,vn,u)),
-		next  (NULL)
-		{
-		}
-
-		Xml::BaseNode::Attribute::~Attribute()
-		{
-			delete [] type;
-			delete next;
-		}
-
-		Xml::BaseNode::~BaseNode()
-		{
-			delete [] type;
-
-			if (*value)
-				delete [] value;
-
-			delete attribute;
-			delete child;
-
-			if (BaseNode* node = sibling)
-			{
-				do
-				{
-					BaseNode* tmp = node->sibling;
-					node->sibling = NULL;
-					delete node;
-					node = tmp;
-				}
-				while (node);
-			}
-		}
-
-		template<typename T,typename U>
-		void Xml::BaseNode::SetValue(T v,T vn,U u)
-		{
-			if (vn-v)
-			{
-				if (!*value)
-					value = SetValue( new wchar_t [vn-v+1], v, vn, u );
-				else
-					throw 1;
-			}
-		}
-
-		void Xml::BaseNode::AddAttribute(utfstring t,utfstring tn,utfstring v,utfstring vn)
-		{
-			if (tn-t)
-			{
-				Attribute** a = &attribute;
-
-				while (*a)
-					a = &(*a)->next;
-
-				(*a) = new Attribute( t, tn, v, vn, BaseNode::IN );
-			}
-			else if (vn-t)
-			{
-				throw 1;
-			}
-		}
-
-		wchar_t* Xml::BaseNode::SetType(wchar_t* NST_RESTRICT dst,utfstring src,utfstring const end,In)
-		{
-			NST_ASSERT( dst && src && end );
-
-			wchar_t* const ptr = dst;
-
-			while (src != end)
-			{
-				const utfchar ch = *src++;
-
-				if (!IsCtrl( ch ))
-				{
-					*dst++ = ToWideChar( ch );
-				}
-				else
-				{
-					delete [] ptr;
-					return NULL;
-				}
-			}
-
-			*dst = L'\0';
-
-			return ptr;
-		}
-
-		wchar_t* Xml::BaseNode::SetType(wchar_t* NST_RESTRICT dst,wcstring src,wcstring const end,Out)
+		template<typename Encoding>
+		uint Xml::Parser<Encoding>::ParseReference(Stream& string,Stream const end)
 		{
-			NST_ASSERT( dst && src && end );
-
-			wchar_t* const ptr = dst;
-
-			while (src != end)
-				*dst++ = *src++;
-
-			*dst = L'\0';
-
-			return ptr;
-		}
-
-		wchar_t* Xml::BaseNode::SetValue(wchar_t* NST_RESTRICT dst,utfstring src,utfstring const end,In)
-		{
-			NST_ASSERT( dst && src && end );
-
-			wchar_t* const ptr = dst;
-
-			while (src != end)
-			{
-				utfchar ch = *src++;
-
-				if (ch == '&')
-					ch = ParseReference( src, end );
-
-				if (!IsCtrl( ch ) || IsVoid( ch ))
-				{
-					*dst++ = ToWideChar( ch );
-				}
-				else
-				{
-					delete [] ptr;
-					return NULL;
-				}
-			}
-
-			*dst = L'\0';
-
-			return ptr;
-		}
-
-		wchar_t* Xml::BaseNode::SetValue(wchar_t* NST_RESTRICT dst,wcstring src,wcstring const end,Out)
-		{
-			NST_ASSERT( dst && src && end );
-
-			wchar_t* const ptr = dst;
-
-			while (src != end)
-				*dst++ = *src++;
-
-			*dst = L'\0';
-
-			return ptr;
-		}
-
-		Xml::utfchar Xml::BaseNode::ParseReference(utfstring& string,utfstring const end)
-		{
-			utfstring src = string;
+			Stream src = string;
 
 			if (end-src >= 3)
 			{
@@ -1016,7 +1094,7 @@ namespace Nes
 				{
 					case '#':
 
-						for (utfstring const offset = src++; src != end; ++src)
+						for (Stream const offset = src++; src != end; ++src)
 						{
 							if (*src == ';')
 							{
@@ -1026,7 +1104,7 @@ namespace Nes
 								{
 									for (dword ch=0, n=0; ; n += (n < 16 ? 4 : 0))
 									{
-										const utfchar v = *--src;
+										const uint v = *--src;
 
 										if (v >= '0' && v <= '9')
 										{
@@ -1050,7 +1128,7 @@ namespace Nes
 								{
 									for (dword ch=0, n=1; ; n *= (n < 100000 ? 10 : 1))
 									{
-										const utfchar v = *--src;
+										const uint v = *--src;
 
 										if (v >= '0' && v <= '9')
 										{
@@ -1255,10 +1333,12 @@ namespace Nes
 			while (*next)
 				next = &(*next)->sibling;
 
-			*next = new BaseNode( type, type + std::wcslen(type), BaseNode::OUT );
+			Arena& arena = *node->arena;
+
+			*next = BaseNode::Create( arena, arena.Copy( type, type + std::wcslen(type) ) );
 
 			if (value && *value)
-				(*next)->SetValue( value, value + std::wcslen(value), BaseNode::OUT );
+				(*next)->value = arena.Copy( value, value + std::wcslen(value) );
 
 			return *next;
 		}
@@ -1272,16 +1352,16 @@ namespace Nes
 				while (*next)
 					next = &(*next)->next;
 
-				*next = new BaseNode::Attribute
-				(
-					type,
-					type + std::wcslen(type),
-					value ? value : L"",
-					value ? value + std::wcslen(value) : NULL,
-					BaseNode::OUT
-				);
-
-				return *next;
+				Arena& arena = *node->arena;
+				BaseNode::Attribute* const attribute = static_cast<BaseNode::Attribute*>(arena.Alloc( sizeof(BaseNode::Attribute) ));
+
+				attribute->type = arena.Copy( type, type + std::wcslen(type) );
+				attribute->value = value ? arena.Copy( value, value + std::wcslen(value) ) : L"";
+				attribute->next = NULL;
+
+				*next = attribute;
+
+				return attribute;
 			}
 
 			return NULL;
@@ -44,52 +44,50 @@ namespace Nes
 			static inline int ToChar(idword);
 			static inline wchar_t ToWideChar(idword);
 
-			class BaseNode
+			class Arena
 			{
-			public:
-
-				enum In {IN};
-				enum Out {OUT};
+				struct Block
+				{
+					Block* next;
+				};
 
-			private:
+				enum
+				{
+					ALIGNMENT = sizeof(void*) > sizeof(wchar_t) ? sizeof(void*) : sizeof(wchar_t),
+					BLOCK_SIZE = 0x10000
+				};
 
-				static utfchar ParseReference(utfstring&,utfstring);
+				Block* blocks;
+				byte* pos;
+				byte* end;
 
-				static wchar_t* SetType(wchar_t* NST_RESTRICT,utfstring,utfstring,In);
-				static wchar_t* SetType(wchar_t* NST_RESTRICT,wcstring,wcstring,Out);
+			public:
 
-				static wchar_t* SetValue(wchar_t* NST_RESTRICT,utfstring,utfstring,In);
-				static wchar_t* SetValue(wchar_t* NST_RESTRICT,wcstring,wcstring,Out);
+				Arena();
+				~Arena();
 
-			public:
+				void* Alloc(dword);
+				wchar_t* Copy(wcstring,wcstring);
+				void Clear();
+			};
 
+			struct BaseNode
+			{
 				struct Attribute
 				{
-					template<typename T,typename U>
-					Attribute(T,T,T,T,U);
-
-					~Attribute();
-
-					wcstring const type;
-					wcstring const value;
+					wcstring type;
+					wcstring value;
 					Attribute* next;
 				};
 
-				template<typename T,typename U>
-				BaseNode(T,T,U);
-
-				~BaseNode();
-
-				template<typename T,typename U>
-				void SetValue(T,T,U);
+				static BaseNode* Create(Arena&,wcstring);
 
-				void AddAttribute(utfstring,utfstring,utfstring,utfstring);
-
-				wcstring const type;
+				wcstring type;
 				wcstring value;
 				Attribute* attribute;
 				BaseNode* child;
 				BaseNode* sibling;
+				Arena* arena;
 			};
 
 			static bool IsEqual(wcstring,wcstring);
@@ -286,7 +284,6 @@ namespace Nes
 
 				const byte* const stream;
 				const dword size;
-				dword pos;
 
 			public:
 
@@ -294,16 +291,21 @@ namespace Nes
 				~Input();
 
 				inline dword Size() const;
+				inline const byte* Data(dword) const;
 
 				inline uint ToByte(dword) const;
 				inline int  ToChar(dword) const;
 				inline uint FromUTF16LE(dword) const;
 				inline uint FromUTF16BE(dword) const;
-
-				uint ReadUTF8();
-				inline void SetReadPointer(dword);
 			};
 
+			struct Utf16;
+			struct Utf8;
+			struct Latin1;
+
+			template<typename Encoding>
+			class Parser;
+
 			class Output
 			{
 				std::ostream& stream;
@@ -348,17 +350,11 @@ namespace Nes
 				inline const Output& operator << (const char (&)[N]) const;
 			};
 
-			static bool IsVoid(utfchar);
-			static bool IsCtrl(utfchar);
-			static Tag CheckTag(utfstring);
-
-			static utfstring SkipVoid(utfstring);
-			static utfstring RewindVoid(utfstring,utfstring=NULL);
-			static utfstring ReadTag(utfstring,BaseNode*&);
-			static utfstring ReadValue(utfstring,BaseNode&);
-			static utfstring ReadNode(utfstring,Tag,BaseNode*&);
+			static bool IsVoid(uint);
+			static bool IsCtrl(uint);
 			static void WriteNode(Node,const Output&,uint);
 
+			Arena arena;
 			BaseNode* root;
 
 		public:
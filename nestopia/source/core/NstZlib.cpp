@@ -49,20 +49,13 @@ namespace Nes
 		{
 		#ifndef NST_NO_ZLIB
 
-			ulong NST_CALL Compress(const byte* src,ulong srcSize,byte* dst,ulong dstSize,Compression compression)
+			ulong NST_CALL Compress(const byte* src,ulong srcSize,byte* dst,ulong dstSize,uint level)
 			{
 				if (srcSize && dstSize)
 				{
-					NST_ASSERT( src && dst );
-
-					int result;
-
-					if (compression == BEST_COMPRESSION)
-						result = compress2( dst, &dstSize, src, srcSize, Z_BEST_COMPRESSION );
-					else
-						result = compress( dst, &dstSize, src, srcSize );
+					NST_ASSERT( src && dst && level >= FASTEST_COMPRESSION && level <= BEST_COMPRESSION );
 
-					if (result == Z_OK)
+					if (compress2( dst, &dstSize, src, srcSize, level ) == Z_OK)
 						return dstSize;
 				}
 
@@ -84,7 +77,7 @@ namespace Nes
 
 		#else
 
-			ulong NST_CALL Compress(const byte*,ulong,byte*,ulong,Compression)
+			ulong NST_CALL Compress(const byte*,ulong,byte*,ulong,uint)
 			{
 				return 0;
 			}
@@ -46,11 +46,12 @@ namespace Nes
 
 			enum Compression
 			{
-				NORMAL_COMPRESSION,
-				BEST_COMPRESSION
+				FASTEST_COMPRESSION = 1,
+				NORMAL_COMPRESSION = 6,
+				BEST_COMPRESSION = 9
 			};
 
-			ulong NST_CALL Compress(const byte*,ulong,byte*,ulong,Compression);
+			ulong NST_CALL Compress(const byte*,ulong,byte*,ulong,uint);
 			ulong NST_CALL Uncompress(const byte*,ulong,byte*,ulong);
 		}
 	}
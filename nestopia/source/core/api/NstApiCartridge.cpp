@@ -387,6 +387,19 @@ namespace Nes
 			return Create() ? emulator.imageDatabase->Load( baseStream, overloadStream ) : RESULT_ERR_OUT_OF_MEMORY;
 		}
 
+		Result Cartridge::Database::Load(const void* mem,ulong size) throw()
+		{
+			if (!mem || !size || size > 0xFFFFFFFF)
+				return RESULT_ERR_INVALID_PARAM;
+
+			return Create() ? emulator.imageDatabase->Load( mem, size ) : RESULT_ERR_OUT_OF_MEMORY;
+		}
+
+		Result Cartridge::Database::Save(std::ostream& stream) const throw()
+		{
+			return emulator.imageDatabase ? emulator.imageDatabase->Save( stream ) : RESULT_ERR_NOT_READY;
+		}
+
 		void Cartridge::Database::Unload() throw()
 		{
 			if (emulator.imageDatabase)
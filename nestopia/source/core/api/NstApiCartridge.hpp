@@ -1015,6 +1015,30 @@ namespace Nes
 				*/
 				Result Load(std::istream& streamInternal,std::istream& streamExternal) throw();
 
+				/**
+				* Resets and attaches a binary database in memory.
+				*
+				* The memory is used in place, entries are only decoded when looked up. It must
+				* stay valid and unchanged until the database is unloaded, so a memory-mapped
+				* file or data embedded in the executable can be passed directly. Binary
+				* databases are also accepted by the stream loaders, which keep a copy.
+				*
+				* @param mem pointer to binary database
+				* @param size size of memory
+				* @return result code
+				*/
+				Result Load(const void* mem,ulong size) throw();
+
+				/**
+				* Saves the loaded database in binary form.
+				*
+				* Used to convert the XML database at build time.
+				*
+				* @param stream output stream
+				* @return result code
+				*/
+				Result Save(std::ostream& stream) const throw();
+
 				/**
 				* Removes all databases from the system.
 				*/
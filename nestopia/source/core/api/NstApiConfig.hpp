@@ -130,5 +130,18 @@
 //
 // NST_NO_2XSAI   - 2xSaI video filter
 //
+// NST_NO_HW_HASH - CPU accelerated CRC-32 and SHA-1 hashing (PCLMUL, SHA-NI,
+//                  ARMv8 CRC32/SHA1). The portable code is used instead.
+//
+// NST_NO_BOARDS_<FAMILY> - Boards of one manufacturer, named as in the source
+//                  files, for instance NST_NO_BOARDS_BMC for NstBoardBmc*.cpp.
+//                  Those sources can then be left out of the build and images
+//                  using them fail with RESULT_ERR_UNSUPPORTED_MAPPER. Only
+//                  families with such a guard in NstBoard.cpp can be named. A few
+//                  of their sources hold boards or sound chips that other boards
+//                  and the NSF player build on and must be compiled regardless:
+//                  NstBoardAveNina, NstBoardDiscrete, NstBoardKonamiVrc1/4/6/7,
+//                  NstBoardNamcot34xx/163 and NstBoardSunsoft4/5b/Fme7.
+//
 ////////////////////////////////////////////////////////////////////////////////////////
 */
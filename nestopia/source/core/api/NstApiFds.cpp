@@ -224,6 +224,16 @@ namespace Nes
 			return emulator.Is(Machine::DISK) && static_cast<const Core::Fds*>(emulator.image)->HasHeader();
 		}
 
+		void Fds::EnableFastLoad(bool enable) throw()
+		{
+			emulator.tracker.EnableFastLoad( enable );
+		}
+
+		bool Fds::IsFastLoadEnabled() const throw()
+		{
+			return emulator.tracker.IsFastLoadEnabled();
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
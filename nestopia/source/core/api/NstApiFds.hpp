@@ -164,6 +164,24 @@ namespace Nes
 			*/
 			bool HasHeader() const throw();
 
+			/**
+			* Enables fast loading. While the disk drive is busy, several frames
+			* are emulated per call to Emulator::Execute() with only the last one
+			* sent to the video and sound outputs. Emulation itself is unchanged.
+			* Has no effect during movie playback or recording, or while the
+			* rewinder is enabled.
+			*
+			* @param state true to enable
+			*/
+			void EnableFastLoad(bool state=true) throw();
+
+			/**
+			* Checks if fast loading is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsFastLoadEnabled() const throw();
+
 			/**
 			* Disk data context.
 			*/
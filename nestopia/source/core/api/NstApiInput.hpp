@@ -106,12 +106,45 @@ namespace Nes
 						MIC = 0x4
 					};
 
+					enum
+					{
+						MAX_EVENTS = 16
+					};
+
+					/**
+					* Timed button change.
+					*/
+					struct Event
+					{
+						/**
+						* Buttons held from this point on.
+						*/
+						uint buttons;
+
+						/**
+						* Host timestamp, mapped onto the frame through Controllers::timing.
+						*/
+						ulong time;
+					};
+
 					uint buttons;
 					uint mic;
 					uint allowSimulAxes;
 
+					/**
+					* Button changes during the frame, in time order. Each one takes
+					* effect when the game polls the pad at or after the CPU cycle its
+					* timestamp maps to, buttons being the state before the first.
+					*/
+					Event events[MAX_EVENTS];
+
+					/**
+					* Number of entries in events, 0 (default) for none.
+					*/
+					uint numEvents;
+
 					Pad()
-					: buttons(0), mic(0), allowSimulAxes(false) {}
+					: buttons(0), mic(0), allowSimulAxes(false), numEvents(0) {}
 
 					typedef bool (NST_CALLBACK *PollCallback) (void*,Pad&,uint);
 
@@ -672,6 +705,24 @@ namespace Nes
 					static PollCaller1<KaraokeStudio> callback;
 				};
 
+				/**
+				* Host time span of the frame being emulated.
+				*
+				* Used for placing timed pad events. Event timestamps are
+				* scaled from begin..end onto the CPU cycles of the frame,
+				* wrapping around like unsigned arithmetic. Events outside
+				* of it, or all with an empty span, apply from the start.
+				*/
+				struct Timing
+				{
+					ulong begin;
+					ulong end;
+
+					Timing()
+					: begin(0), end(0) {}
+				};
+
+				Timing timing;
 				Pad pad[NUM_PADS];
 				Zapper zapper;
 				Paddle paddle;
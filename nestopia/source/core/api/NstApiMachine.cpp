@@ -23,9 +23,11 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 
 #include <new>
+#include <istream>
 #include "../NstMachine.hpp"
 #include "../NstImage.hpp"
 #include "../NstState.hpp"
+#include "../NstRomSource.hpp"
 #include "NstApiMachine.hpp"
 
 namespace Nes
@@ -53,7 +55,7 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
-		Result Machine::Load(std::istream& stream,FavoredSystem system,AskProfile ask,Patch* patch,uint type)
+		Result Machine::Load(std::istream& stream,const Core::RomSource* source,FavoredSystem system,AskProfile ask,Patch* patch,uint type)
 		{
 			Result result;
 
@@ -64,6 +66,7 @@ namespace Nes
 				result = emulator.Load
 				(
 					stream,
+					source,
 					static_cast<Core::FavoredSystem>(system),
 					ask == ASK_PROFILE,
 					patch ? &patch->stream : NULL,
@@ -93,32 +96,53 @@ namespace Nes
 
 		Result Machine::Load(std::istream& stream,FavoredSystem system,AskProfile ask) throw()
 		{
-			return Load( stream, system, ask, NULL, Core::Image::UNKNOWN );
+			return Load( stream, NULL, system, ask, NULL, Core::Image::UNKNOWN );
 		}
 
 		Result Machine::Load(std::istream& stream,FavoredSystem system,Patch& patch,AskProfile ask) throw()
 		{
-			return Load( stream, system, ask, &patch, Core::Image::UNKNOWN );
+			return Load( stream, NULL, system, ask, &patch, Core::Image::UNKNOWN );
+		}
+
+		Result Machine::Load(const void* data,ulong length,FavoredSystem system,AskProfile ask,Patch* patch)
+		{
+			if (!data || !length)
+				return RESULT_ERR_INVALID_PARAM;
+
+			Core::RomSource source( data, length );
+			std::istream stream( &source );
+
+			return Load( stream, &source, system, ask, patch, Core::Image::UNKNOWN );
+		}
+
+		Result Machine::Load(const void* data,ulong length,FavoredSystem system,AskProfile ask) throw()
+		{
+			return Load( data, length, system, ask, NULL );
+		}
+
+		Result Machine::Load(const void* data,ulong length,FavoredSystem system,Patch& patch,AskProfile ask) throw()
+		{
+			return Load( data, length, system, ask, &patch );
 		}
 
 		Result Machine::LoadCartridge(std::istream& stream,FavoredSystem system,AskProfile ask) throw()
 		{
-			return Load( stream, system, ask, NULL, Core::Image::CARTRIDGE );
+			return Load( stream, NULL, system, ask, NULL, Core::Image::CARTRIDGE );
 		}
 
 		Result Machine::LoadCartridge(std::istream& stream,FavoredSystem system,Patch& patch,AskProfile ask) throw()
 		{
-			return Load( stream, system, ask, &patch, Core::Image::CARTRIDGE );
+			return Load( stream, NULL, system, ask, &patch, Core::Image::CARTRIDGE );
 		}
 
 		Result Machine::LoadDisk(std::istream& stream,FavoredSystem system) throw()
 		{
-			return Load( stream, system, DONT_ASK_PROFILE, NULL, Core::Image::DISK );
+			return Load( stream, NULL, system, DONT_ASK_PROFILE, NULL, Core::Image::DISK );
 		}
 
 		Result Machine::LoadSound(std::istream& stream,FavoredSystem system) throw()
 		{
-			return Load( stream, system, DONT_ASK_PROFILE, NULL, Core::Image::SOUND );
+			return Load( stream, NULL, system, DONT_ASK_PROFILE, NULL, Core::Image::SOUND );
 		}
 
 		Result Machine::Unload() throw()
@@ -250,15 +274,142 @@ namespace Nes
 			}
 		}
 
-		Result Machine::SaveState(std::ostream& stream,Compression compression) const throw()
+		Result Machine::SaveState(std::ostream& stream,Compression compression,uint level) const throw()
+		{
+			if (!Is(GAME,ON))
+				return RESULT_ERR_NOT_READY;
+
+			if (level < MIN_COMPRESSION_LEVEL || level > MAX_COMPRESSION_LEVEL)
+				return RESULT_ERR_INVALID_PARAM;
+
+			Core::State::Compression codec = Core::State::NO_COMPRESSION;
+
+			if (compression == USE_COMPRESSION)
+				codec = Core::State::ZLIB_COMPRESSION;
+			else if (compression == FAST_COMPRESSION)
+				codec = Core::State::FAST_COMPRESSION;
+
+			try
+			{
+				Core::State::Saver saver( &stream, codec, false, 0, level );
+
+				emulator.SaveState( saver );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Machine::SaveIncrementalState(std::ostream& stream,bool rebase) const throw()
+		{
+			if (!Is(GAME,ON))
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				if (!emulator.stateBase)
+					emulator.stateBase = new Core::State::Baseline;
+				else if (rebase)
+					emulator.stateBase->Reset();
+
+				Core::State::Saver saver( &stream, Core::State::NO_COMPRESSION, false, 0, Core::State::MAX_ZLIB_LEVEL, emulator.stateBase );
+
+				emulator.SaveState( saver );
+			}
+			catch (Result result)
+			{
+				emulator.stateBase->Reset();
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				if (emulator.stateBase)
+					emulator.stateBase->Reset();
+
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				emulator.stateBase->Reset();
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Machine::LoadIncrementalState(std::istream& stream) throw()
+		{
+			if (!Is(GAME,ON) || IsLocked())
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				emulator.tracker.Resync();
+				Core::State::Loader loader( &stream, true, emulator.stateBase );
+
+				if (emulator.LoadState( loader, true ))
+					return RESULT_OK;
+				else
+					return RESULT_ERR_INVALID_CRC;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		ulong Machine::GetStateSize() const throw()
+		{
+			if (!Is(GAME,ON))
+				return 0;
+
+			try
+			{
+				Core::State::Saver saver( NULL, 0, false );
+				emulator.SaveState( saver );
+
+				return saver.Size();
+			}
+			catch (...)
+			{
+				return 0;
+			}
+		}
+
+		Result Machine::SaveState(void* const data,const ulong size) const throw()
 		{
 			if (!Is(GAME,ON))
 				return RESULT_ERR_NOT_READY;
 
+			if (!data)
+				return RESULT_ERR_INVALID_PARAM;
+
 			try
 			{
-				Core::State::Saver saver( &stream, compression != NO_COMPRESSION, false );
+				Core::State::Saver saver( static_cast<byte*>(data), size, false );
 				emulator.SaveState( saver );
+
+				if (saver.Size() > size)
+					return RESULT_ERR_INVALID_PARAM;
 			}
 			catch (Result result)
 			{
@@ -276,6 +427,58 @@ namespace Nes
 			return RESULT_OK;
 		}
 
+		Result Machine::LoadState(const void* const data,const ulong size) throw()
+		{
+			if (!Is(GAME,ON) || IsLocked())
+				return RESULT_ERR_NOT_READY;
+
+			if (!data)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.tracker.Resync();
+				Core::State::Loader loader( static_cast<const byte*>(data), size, true );
+
+				if (emulator.LoadState( loader, true ))
+					return RESULT_OK;
+				else
+					return RESULT_ERR_INVALID_CRC;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		Result Machine::SetRunAhead(const uint frames) throw()
+		{
+			if (frames > MAX_RUN_AHEAD)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				return emulator.tracker.SetRunAhead( frames );
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+		}
+
+		uint Machine::GetRunAhead() const throw()
+		{
+			return emulator.tracker.GetRunAhead();
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -42,6 +42,11 @@
 
 namespace Nes
 {
+	namespace Core
+	{
+		class RomSource;
+	}
+
 	namespace Api
 	{
 		/**
@@ -194,6 +199,36 @@ namespace Nes
 			*/
 			Result Load(std::istream& stream,FavoredSystem system,Patch& patch,AskProfile askProfile=DONT_ASK_PROFILE) throw();
 
+			/**
+			* Loads any image from memory. Data can be in XML, iNES, UNIF, FDS or NSF format.
+			*
+			* Unpatched iNES ROM data is referenced in place rather than copied, so machines
+			* loaded from the same buffer, such as a memory-mapped file, share a single copy.
+			* The buffer must stay valid and unchanged until the image is unloaded.
+			*
+			* @param data image data
+			* @param length length of image data
+			* @param system console to emulate if the core can't do automatic detection
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const void* data,ulong length,FavoredSystem system,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
+			/**
+			* Loads any image from memory. Data can be in XML, iNES, UNIF, FDS or NSF format.
+			*
+			* ROM data is copied where the patch applies, the buffer itself is never written to.
+			* The buffer must stay valid and unchanged until the image is unloaded.
+			*
+			* @param data image data
+			* @param length length of image data
+			* @param system console to emulate if the core can't do automatic detection
+			* @param patch object for performing soft-patching on the image
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const void* data,ulong length,FavoredSystem system,Patch& patch,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
 			/**
 			* Loads a cartridge image. Input stream can be in XML, iNES or UNIF format.
 			*
@@ -296,9 +331,25 @@ namespace Nes
 				*/
 				NO_COMPRESSION,
 				/**
-				* Compression enabled (default).
+				* zlib compression (default), falls back to FAST_COMPRESSION in builds without zlib.
+				*/
+				USE_COMPRESSION,
+				/**
+				* Built-in LZ4 block compression, much faster than zlib at a lower ratio.
 				*/
-				USE_COMPRESSION
+				FAST_COMPRESSION
+			};
+
+			enum
+			{
+				/**
+				* Lowest zlib compression level, fastest.
+				*/
+				MIN_COMPRESSION_LEVEL = 1,
+				/**
+				* Highest zlib compression level, smallest (default).
+				*/
+				MAX_COMPRESSION_LEVEL = 9
 			};
 
 			/**
@@ -312,11 +363,100 @@ namespace Nes
 			/**
 			* Saves a state.
 			*
+			* The codec used is recorded per chunk so LoadState() reads any of them.
+			*
 			* @param stream output stream which the state will be written to
 			* @param compression to allow internal compression in the state, default is USE_COMPRESSION
+			* @param level zlib compression level used with USE_COMPRESSION, MIN_COMPRESSION_LEVEL to MAX_COMPRESSION_LEVEL
+			* @return result code
+			*/
+			Result SaveState(std::ostream& stream,Compression compression=USE_COMPRESSION,uint level=MAX_COMPRESSION_LEVEL) const throw();
+
+			/**
+			* Saves an incremental state.
+			*
+			* The first call after loading a game, or any call with rebase set, captures
+			* the RAM, nametable and CHR-RAM blocks as a base and writes a full state. Later
+			* calls only write the 256 byte pages of those blocks that differ from the base.
+			* The output is a regular state, readable by LoadIncrementalState() for as long
+			* as the base is kept.
+			*
+			* @param stream output stream which the state will be written to
+			* @param rebase to capture a new base from the current state
 			* @return result code
 			*/
-			Result SaveState(std::ostream& stream,Compression compression=USE_COMPRESSION) const throw();
+			Result SaveIncrementalState(std::ostream& stream,bool rebase=false) const throw();
+
+			/**
+			* Loads a state saved by SaveIncrementalState().
+			*
+			* @param stream input stream containing the state
+			* @return result code, RESULT_ERR_CORRUPT_FILE if the state refers to a base that is no longer kept
+			*/
+			Result LoadIncrementalState(std::istream& stream) throw();
+
+			/**
+			* Returns the size of a state saved to memory.
+			*
+			* The size is taken from a save that writes nothing and stays the same
+			* until the game or the connected devices change.
+			*
+			* @return size in bytes, 0 if no game is running
+			*/
+			ulong GetStateSize() const throw();
+
+			/**
+			* Saves a state to memory.
+			*
+			* Writes the same data as SaveState() with NO_COMPRESSION, straight into the
+			* buffer and without going through a stream.
+			*
+			* @param data buffer the state will be written to
+			* @param size size of the buffer, at least GetStateSize()
+			* @return result code, RESULT_ERR_INVALID_PARAM if the buffer is too small
+			*/
+			Result SaveState(void* data,ulong size) const throw();
+
+			/**
+			* Loads a state from memory.
+			*
+			* Reads uncompressed states, such as those saved by SaveState(void*,ulong).
+			*
+			* @param data buffer containing the state
+			* @param size size of the state
+			* @return result code
+			*/
+			Result LoadState(const void* data,ulong size) throw();
+
+			enum
+			{
+				/**
+				* Most frames that can be run ahead.
+				*/
+				MAX_RUN_AHEAD = 4
+			};
+
+			/**
+			* Sets the number of frames to run ahead.
+			*
+			* Each call to Emulator::Execute() then emulates one frame for the sound
+			* output, keeps its state in memory, emulates the given number of frames
+			* further on the same input for the video output and restores the state.
+			* This hides as many frames of the game's own input lag at the cost of
+			* emulating them on every call. Has no effect during movie playback or
+			* recording, or while the rewinder is enabled.
+			*
+			* @param frames number of frames, 0 (default) to disable, at most MAX_RUN_AHEAD
+			* @return result code
+			*/
+			Result SetRunAhead(uint frames) throw();
+
+			/**
+			* Returns the number of frames to run ahead.
+			*
+			* @return number of frames, 0 if disabled
+			*/
+			uint GetRunAhead() const throw();
 
 			/**
 			* Returns a machine state.
@@ -408,7 +548,8 @@ namespace Nes
 
 		private:
 
-			Result Load(std::istream&,FavoredSystem,AskProfile,Patch*,uint);
+			Result Load(std::istream&,const Core::RomSource*,FavoredSystem,AskProfile,Patch*,uint);
+			Result Load(const void*,ulong,FavoredSystem,AskProfile,Patch*);
 		};
 
 		/**
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <new>
+#include "../NstMachine.hpp"
+#include "NstApiMachine.hpp"
+#include "NstApiNetplay.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Netplay
+		{
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("s", on)
+			#endif
+
+			Loopback::Loopback(uint d) throw()
+			:
+			peer  (NULL),
+			delay (d),
+			clock (0),
+			head  (0),
+			count (0)
+			{}
+
+			void Loopback::Connect(Loopback& other) throw()
+			{
+				peer = &other;
+				other.peer = this;
+			}
+
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("", on)
+			#endif
+
+			void Loopback::Send(const Packet& packet) throw()
+			{
+				NST_VERIFY( peer && peer->count < QUEUE_SIZE );
+
+				if (peer && peer->count < QUEUE_SIZE)
+				{
+					Entry& entry = peer->queue[(peer->head + peer->count++) % QUEUE_SIZE];
+					entry.packet = packet;
+					entry.due = peer->clock + delay;
+				}
+			}
+
+			bool Loopback::Receive(Packet& packet) throw()
+			{
+				if (count && queue[head].due <= clock)
+				{
+					packet = queue[head].packet;
+					head = (head + 1) % QUEUE_SIZE;
+					--count;
+					return true;
+				}
+
+				// end of a round, held back packets come one step closer
+
+				++clock;
+				return false;
+			}
+		}
+	}
+
+	namespace Api
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Result Netplay::Start(Transport& transport,uint player,uint players,uint frames) throw()
+		{
+			if (players < 2 || players > MAX_PLAYERS || player >= players || !frames || frames > MAX_FRAMES)
+				return RESULT_ERR_INVALID_PARAM;
+
+			if (!emulator.Is(Machine::GAME,Machine::ON))
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				return emulator.tracker.StartRollback( emulator, transport, player, players, frames );
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		void Netplay::Stop() throw()
+		{
+			emulator.tracker.StopRollback();
+		}
+
+		bool Netplay::IsActive() const throw()
+		{
+			return emulator.tracker.IsRollbackActive();
+		}
+
+		bool Netplay::IsDesynced() const throw()
+		{
+			return emulator.tracker.GetRollbackDesync();
+		}
+
+		ulong Netplay::GetDesyncFrame() const throw()
+		{
+			return emulator.tracker.GetRollbackDesync();
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
@@ -0,0 +1,249 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef NST_API_NETPLAY_H
+#define NST_API_NETPLAY_H
+
+#include "NstApi.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_ICC >= 810
+#pragma warning( push )
+#pragma warning( disable : 304 444 )
+#elif NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Netplay
+		{
+			/**
+			* Message exchanged between peers, one per emulated frame.
+			*/
+			struct Packet
+			{
+				/**
+				* Frame the input is for.
+				*/
+				ulong frame;
+
+				/**
+				* Pad index of the sending player.
+				*/
+				uint player;
+
+				/**
+				* Pad buttons held during the frame.
+				*/
+				uint buttons;
+
+				/**
+				* Last frame whose state the sender has confirmed, 0 if none yet.
+				*/
+				ulong hashFrame;
+
+				/**
+				* Hash of the sender's state at the start of hashFrame.
+				*/
+				ulong hash;
+			};
+
+			/**
+			* Connection to the other peers.
+			*
+			* Packets must arrive complete and in the order they were sent. A transport
+			* over an unreliable network is expected to handle resending on its own.
+			*/
+			class Transport
+			{
+			public:
+
+				virtual ~Transport() {}
+
+				/**
+				* Sends a packet to all other peers.
+				*
+				* @param packet packet
+				*/
+				virtual void Send(const Packet& packet) throw() = 0;
+
+				/**
+				* Fetches the next received packet, if any.
+				*
+				* @param packet packet to fill in
+				* @return true if a packet was received
+				*/
+				virtual bool Receive(Packet& packet) throw() = 0;
+			};
+
+			/**
+			* In-process transport linking two emulator instances, for testing.
+			*/
+			class Loopback : public Transport
+			{
+			public:
+
+				/**
+				* Constructor.
+				*
+				* @param delay number of receive rounds a packet is held back, simulating latency
+				*/
+				explicit Loopback(uint delay=0) throw();
+
+				/**
+				* Links two endpoints to each other.
+				*
+				* @param peer other endpoint
+				*/
+				void Connect(Loopback& peer) throw();
+
+				void Send(const Packet&) throw();
+				bool Receive(Packet&) throw();
+
+			private:
+
+				enum
+				{
+					QUEUE_SIZE = 256
+				};
+
+				struct Entry
+				{
+					Packet packet;
+					ulong due;
+				};
+
+				Loopback* peer;
+				const uint delay;
+				ulong clock;
+				uint head;
+				uint count;
+				Entry queue[QUEUE_SIZE];
+			};
+		}
+	}
+
+	namespace Api
+	{
+		/**
+		* Rollback netplay interface.
+		*
+		* Remote input that hasn't arrived yet is predicted to be the same as the player's
+		* last known input. When the real input differs, the frames since are run again from
+		* a snapshot with no video or sound output. Each side sends a hash of the last state
+		* it knows to be final so that peers drifting apart can be detected. All peers must
+		* start from the same state, e.g. a fresh power-on of the same image.
+		*/
+		class Netplay : public Base
+		{
+		public:
+
+			/**
+			* Interface constructor.
+			*
+			* @param instance emulator instance
+			*/
+			template<typename T>
+			Netplay(T& instance)
+			: Base(instance) {}
+
+			typedef Core::Netplay::Packet Packet;
+			typedef Core::Netplay::Transport Transport;
+			typedef Core::Netplay::Loopback Loopback;
+
+			enum
+			{
+				/**
+				* Maximum number of players.
+				*/
+				MAX_PLAYERS = 4,
+				/**
+				* Default number of frames to run ahead of remote input.
+				*/
+				DEFAULT_FRAMES = 8,
+				/**
+				* Maximum number of frames to run ahead of remote input.
+				*/
+				MAX_FRAMES = 16
+			};
+
+			/**
+			* Starts a session.
+			*
+			* Input for the local player is taken from its pad in the controllers passed to
+			* Emulator::Execute(), while every pad seen by the game is driven by the session.
+			* Emulator::Execute() returns RESULT_NOP without running a frame when the remote
+			* input is more than <i>frames</i> frames behind. The transport must stay alive until
+			* the session is stopped.
+			*
+			* @param transport connection to the other peers
+			* @param player pad index of the local player
+			* @param players number of players, 2 to MAX_PLAYERS
+			* @param frames frames to run ahead of remote input, 1 to MAX_FRAMES
+			* @return result code
+			*/
+			Result Start(Transport& transport,uint player,uint players=2,uint frames=DEFAULT_FRAMES) throw();
+
+			/**
+			* Stops the session.
+			*/
+			void Stop() throw();
+
+			/**
+			* Checks if a session is running.
+			*
+			* @return true if running
+			*/
+			bool IsActive() const throw();
+
+			/**
+			* Checks if the peers have drifted apart.
+			*
+			* @return true if a state hash didn't match
+			*/
+			bool IsDesynced() const throw();
+
+			/**
+			* Returns the first frame a state hash didn't match.
+			*
+			* @return frame, 0 if none
+			*/
+			ulong GetDesyncFrame() const throw();
+		};
+	}
+}
+
+#if NST_MSVC >= 1200 || NST_ICC >= 810
+#pragma warning( pop )
+#endif
+
+#endif
@@ -25,6 +25,7 @@
 #include "../NstMachine.hpp"
 #include "../NstNsf.hpp"
 #include "NstApiMachine.hpp"
+#include "NstApiSound.hpp"
 #include "NstApiNsf.hpp"
 
 namespace Nes
@@ -175,6 +176,81 @@ namespace Nes
 			return RESULT_ERR_NOT_READY;
 		}
 
+		template<typename T,int CENTER>
+		static ulong CountSilence(const void* const data,const ulong length,ulong silent,bool& audible)
+		{
+			enum {THRESHOLD = CENTER ? 1 : 16};
+
+			for (const T *NST_RESTRICT it = static_cast<const T*>(data), *const end = it + length; it != end; ++it)
+			{
+				const int sample = int(*it) - CENTER;
+
+				if (sample > THRESHOLD || sample < -THRESHOLD)
+				{
+					silent = 0;
+					audible = true;
+				}
+				else
+					++silent;
+			}
+
+			return silent;
+		}
+
+		ulong Nsf::Render(void* const samples,const ulong length,const ulong silence) throw()
+		{
+			if (!emulator.Is(Machine::SOUND) || !emulator.Is(Machine::ON) || !samples || !static_cast<Core::Nsf*>(emulator.image)->IsPlaying())
+				return 0;
+
+			Core::Apu& apu = emulator.cpu.GetApu();
+
+			const bool wide = (apu.GetSampleBits() == 16);
+			const uint channels = apu.InStereo() ? 2 : 1;
+			const uint size = (wide ? 2 : 1) * channels;
+			const qaword clock = emulator.cpu.GetClockBase();
+			const qaword step = qaword(apu.GetSampleRate()) * emulator.cpu.GetFrameCycles();
+
+			qaword phase = 0;
+			ulong rendered = 0;
+			ulong silent = 0;
+			bool audible = false;
+
+			apu.EnableCallbacks( false );
+
+			while (rendered < length)
+			{
+				phase += step;
+
+				ulong count = ulong(phase / clock);
+				phase -= count * clock;
+
+				if (count > length - rendered)
+					count = length - rendered;
+
+				void* const data = static_cast<byte*>(samples) + rendered * size;
+
+				Core::Sound::Output output( data, count );
+				emulator.Execute( NULL, &output, NULL );
+
+				rendered += count;
+
+				if (silence)
+				{
+					if (wide)
+						silent = CountSilence<iword,0>( data, count * channels, silent * channels, audible ) / channels;
+					else
+						silent = CountSilence<byte,0x80>( data, count * channels, silent * channels, audible ) / channels;
+
+					if (audible && silent >= silence)
+						break;
+				}
+			}
+
+			apu.EnableCallbacks( true );
+
+			return rendered;
+		}
+
 		bool Nsf::IsPlaying() const throw()
 		{
 			return emulator.Is(Machine::SOUND) && static_cast<Core::Nsf*>(emulator.image)->IsPlaying();
@@ -223,6 +223,21 @@ namespace Nes
 			*/
 			Result StopSong() throw();
 
+			/**
+			* Renders the current song straight into a buffer.
+			*
+			* Runs the song frame by frame the same way Emulator::Execute() would but without
+			* video or input and without invoking the sound lock/unlock callbacks, so separate
+			* emulator instances can render concurrently from different threads. Samples are
+			* written in the format set through the Sound interface. The song must be playing.
+			*
+			* @param samples destination buffer
+			* @param length maximum <b>number of</b> samples to render
+			* @param silence number of consecutive silent samples after which to stop, counted only once the song has made a sound, 0 to always render the full length
+			* @return number of samples rendered
+			*/
+			ulong Render(void* samples,ulong length,ulong silence=0) throw();
+
 			/**
 			* Event.
 			*/
@@ -72,6 +72,40 @@ namespace Nes
 			emulator.tracker.EnableRewinderSound( enable );
 		}
 
+		Result Rewinder::SetHistory(uint keys,uint frames,ulong memory) throw()
+		{
+			if (keys < MIN_KEYS || keys > MAX_KEYS || frames < MIN_KEY_FRAMES || frames > MAX_KEY_FRAMES || (frames & 1) || memory < MIN_MEMORY || memory > MAX_MEMORY)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				return emulator.tracker.SetRewinderHistory( keys, frames, memory );
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		uint Rewinder::GetHistoryKeys() const throw()
+		{
+			return emulator.tracker.GetRewinderKeys();
+		}
+
+		uint Rewinder::GetHistoryKeyFrames() const throw()
+		{
+			return emulator.tracker.GetRewinderFrames();
+		}
+
+		ulong Rewinder::GetHistoryMemory() const throw()
+		{
+			return emulator.tracker.GetRewinderMemory();
+		}
+
 		Rewinder::Direction Rewinder::GetDirection() const throw()
 		{
 			return emulator.tracker.IsRewinding() ? BACKWARD : FORWARD;
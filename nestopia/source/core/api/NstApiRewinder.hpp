@@ -110,6 +110,82 @@ namespace Nes
 			*/
 			bool IsSoundEnabled() const throw();
 
+			enum
+			{
+				/**
+				* Default number of keys kept.
+				*/
+				DEFAULT_KEYS = 60,
+				/**
+				* Minimum number of keys kept.
+				*/
+				MIN_KEYS = 2,
+				/**
+				* Maximum number of keys kept.
+				*/
+				MAX_KEYS = 0x10000,
+				/**
+				* Default number of frames between keys.
+				*/
+				DEFAULT_KEY_FRAMES = 60,
+				/**
+				* Minimum number of frames between keys.
+				*/
+				MIN_KEY_FRAMES = 2,
+				/**
+				* Maximum number of frames between keys.
+				*/
+				MAX_KEY_FRAMES = 240,
+				/**
+				* Default memory budget for the key history.
+				*/
+				DEFAULT_MEMORY = 0x400000,
+				/**
+				* Minimum memory budget for the key history.
+				*/
+				MIN_MEMORY = 0x10000,
+				/**
+				* Maximum memory budget for the key history.
+				*/
+				MAX_MEMORY = 0x40000000
+			};
+
+			/**
+			* Sets the rewind history.
+			*
+			* A key state is stored every <i>frames</i> frames, delta compressed against its
+			* neighbour into a single ring buffer of <i>memory</i> bytes. Rewinding reaches back
+			* <i>keys</i> times <i>frames</i> frames at most, less if the ring runs out of room
+			* first. Changing the settings clears the current history.
+			*
+			* @param keys number of keys, MIN_KEYS to MAX_KEYS
+			* @param frames number of frames between keys, an even number from MIN_KEY_FRAMES to MAX_KEY_FRAMES
+			* @param memory size of the ring buffer in bytes, MIN_MEMORY to MAX_MEMORY
+			* @return result code
+			*/
+			Result SetHistory(uint keys,uint frames,ulong memory) throw();
+
+			/**
+			* Returns the number of keys kept.
+			*
+			* @return number of keys
+			*/
+			uint GetHistoryKeys() const throw();
+
+			/**
+			* Returns the number of frames between keys.
+			*
+			* @return number of frames
+			*/
+			uint GetHistoryKeyFrames() const throw();
+
+			/**
+			* Returns the memory budget for the key history.
+			*
+			* @return size in bytes
+			*/
+			ulong GetHistoryMemory() const throw();
+
 			/**
 			* Sets direction.
 			*
@@ -0,0 +1,606 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <new>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include "../NstStream.hpp"
+#include "../NstChecksum.hpp"
+#include "NstApiMachine.hpp"
+#include "NstApiScanner.hpp"
+
+namespace Nes
+{
+	namespace Api
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		class Scanner::Reader
+		{
+			enum
+			{
+				INES_ID = Core::AsciiId<'N','E','S'>::V | 0x1AUL << 24,
+				UNIF_ID = Core::AsciiId<'U','N','I','F'>::V,
+				FDS_ID = Core::AsciiId<'F','D','S'>::V | 0x1AUL << 24,
+				FDS_RAW_ID = 0x01UL | Core::AsciiId<'*','N','I'>::V << 8,
+				NSF_ID = Core::AsciiId<'N','E','S','M'>::V,
+				INES_HEADER_LENGTH = 16,
+				INES_TRAINER_LENGTH = 0x200,
+				UNIF_HEADER_LENGTH = 32,
+				FDS_HEADER_LENGTH = 16,
+				NSF_HEADER_LENGTH = 0x80,
+				NSF_NAME_OFFSET = 0x0E,
+				NSF_NAME_LENGTH = 32,
+				NSF_REGION_OFFSET = 0x7A,
+				MAX_NAME_LENGTH = 0xFF,
+				BUFFER_LENGTH = Core::SIZE_8K
+			};
+
+			Core::Stream::In stream;
+			Info& info;
+			const bool hash;
+
+			static void SetTitle(std::wstring& title,const byte* string,dword length)
+			{
+				dword i = 0;
+
+				while (i < length && string[i])
+					++i;
+
+				title.assign( string, string + i );
+			}
+
+			void Hash(Core::Checksum& checksum,dword length)
+			{
+				byte buffer[BUFFER_LENGTH];
+
+				while (length)
+				{
+					const dword size = NST_MIN(length,dword(BUFFER_LENGTH));
+					stream.Read( buffer, size );
+					checksum.Compute( buffer, size );
+					length -= size;
+				}
+			}
+
+			void Skip(dword length)
+			{
+				for (; length > 0x7FFFFFFF; length -= 0x7FFFFFFF)
+					stream.Seek( 0x7FFFFFFF );
+
+				if (length)
+					stream.Seek( length );
+			}
+
+			void ReadInes()
+			{
+				byte header[INES_HEADER_LENGTH];
+				stream.Read( header );
+
+				Cartridge::NesHeader setup;
+
+				if (NES_FAILED(setup.Import( header, INES_HEADER_LENGTH )))
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				info.type = TYPE_INES;
+				info.mapper = setup.mapper;
+				info.subMapper = setup.subMapper;
+				info.prgRom = setup.prgRom;
+				info.chrRom = setup.chrRom;
+
+				switch (setup.system)
+				{
+					case Cartridge::NesHeader::SYSTEM_VS:   info.system = Cartridge::Profile::System::VS_UNISYSTEM;  break;
+					case Cartridge::NesHeader::SYSTEM_PC10: info.system = Cartridge::Profile::System::PLAYCHOICE_10; break;
+					default:
+
+						info.system = (setup.region == Cartridge::NesHeader::REGION_PAL ? Cartridge::Profile::System::NES_PAL : Cartridge::Profile::System::NES_NTSC);
+						break;
+				}
+
+				if (hash)
+				{
+					if (setup.trainer)
+						stream.Seek( INES_TRAINER_LENGTH );
+
+					// Truncated dumps are hashed as far as they go, like the loader does
+
+					dword length = stream.Length();
+
+					if (length > setup.prgRom + setup.chrRom)
+						length = setup.prgRom + setup.chrRom;
+
+					Core::Checksum checksum;
+					Hash( checksum, length );
+					info.hash.Assign( checksum.GetSha1(), checksum.GetCrc() );
+				}
+			}
+
+			void ReadUnif()
+			{
+				Skip( UNIF_HEADER_LENGTH );
+
+				info.type = TYPE_UNIF;
+
+				std::vector<byte> roms[2][16];
+
+				while (!stream.Eof())
+				{
+					const dword id = stream.Read32();
+					dword length = stream.Read32();
+
+					switch (id)
+					{
+						case Core::AsciiId<'N','A','M','E'>::V:
+
+							if (length)
+							{
+								byte name[MAX_NAME_LENGTH];
+								const dword size = NST_MIN(length,dword(MAX_NAME_LENGTH));
+
+								stream.Read( name, size );
+								SetTitle( info.title, name, size );
+								length -= size;
+							}
+							break;
+
+						case Core::AsciiId<'T','V','C','I'>::V:
+
+							if (length)
+							{
+								info.system = (stream.Read8() == 1 ? Cartridge::Profile::System::NES_PAL : Cartridge::Profile::System::NES_NTSC);
+								length -= 1;
+							}
+							break;
+
+						default:
+
+							if ((id & 0x00FFFFFF) == Core::AsciiId<'P','R','G'>::V || (id & 0x00FFFFFF) == Core::AsciiId<'C','H','R'>::V)
+							{
+								const uint part = ((id & 0x00FFFFFF) == Core::AsciiId<'C','H','R'>::V);
+								uint index = id >> 24 & 0xFF;
+
+								if (index >= '0' && index <= '9')
+									index -= '0';
+								else if (index >= 'A' && index <= 'F')
+									index = index - 'A' + 10;
+								else
+									break;
+
+								(part ? info.chrRom : info.prgRom) += length;
+
+								if (hash && length)
+								{
+									roms[part][index].resize( length );
+									stream.Read( &roms[part][index].front(), length );
+									length = 0;
+								}
+							}
+							break;
+					}
+
+					Skip( length );
+				}
+
+				if (hash)
+				{
+					// Same order the loader lays the chunks out in memory
+
+					Core::Checksum checksum;
+
+					for (uint i=0; i < 2; ++i)
+					{
+						for (uint j=0; j < 16; ++j)
+						{
+							if (!roms[i][j].empty())
+								checksum.Compute( &roms[i][j].front(), roms[i][j].size() );
+						}
+					}
+
+					info.hash.Assign( checksum.GetSha1(), checksum.GetCrc() );
+				}
+			}
+
+			void ReadFds(bool header)
+			{
+				if (header)
+					Skip( FDS_HEADER_LENGTH );
+
+				info.type = TYPE_FDS;
+				info.system = Cartridge::Profile::System::FAMICOM;
+				info.prgRom = stream.Length();
+
+				ReadData();
+			}
+
+			void ReadNsf()
+			{
+				byte header[NSF_HEADER_LENGTH];
+				stream.Read( header );
+
+				info.type = TYPE_NSF;
+				info.system = ((header[NSF_REGION_OFFSET] & 0x3U) == 0x1U ? Cartridge::Profile::System::NES_PAL : Cartridge::Profile::System::NES_NTSC);
+				info.prgRom = stream.Length();
+
+				SetTitle( info.title, header + NSF_NAME_OFFSET, NSF_NAME_LENGTH );
+
+				ReadData();
+			}
+
+			void ReadData()
+			{
+				if (hash)
+				{
+					Core::Checksum checksum;
+					Hash( checksum, info.prgRom );
+					info.hash.Assign( checksum.GetSha1(), checksum.GetCrc() );
+				}
+			}
+
+		public:
+
+			Reader(std::istream& s,Info& i,bool h)
+			: stream(&s), info(i), hash(h)
+			{
+				info.Clear();
+			}
+
+			void Read()
+			{
+				switch (const dword id = stream.Peek32())
+				{
+					case INES_ID: ReadInes(); break;
+					case UNIF_ID: ReadUnif(); break;
+					case FDS_ID:  ReadFds( true ); break;
+
+					default:
+
+						if (id == NSF_ID)
+						{
+							ReadNsf();
+						}
+						else if (id == FDS_RAW_ID)
+						{
+							ReadFds( false );
+						}
+						else
+						{
+							throw RESULT_ERR_INVALID_FILE;
+						}
+						break;
+				}
+			}
+		};
+
+		Scanner::Info::Info() throw()
+		{
+			Clear();
+		}
+
+		void Scanner::Info::Clear() throw()
+		{
+			type = TYPE_UNKNOWN;
+			system = Cartridge::Profile::System::NES_NTSC;
+			mapper = 0;
+			subMapper = 0;
+			prgRom = 0;
+			chrRom = 0;
+			hash.Clear();
+			title.clear();
+			matched = false;
+		}
+
+		Result Scanner::Read(std::istream& stream,Info& info,bool hash) throw()
+		{
+			try
+			{
+				Reader( stream, info, hash ).Read();
+			}
+			catch (Result result)
+			{
+				info.Clear();
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				info.Clear();
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				info.Clear();
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		bool Scanner::Match(const Cartridge::Database& database,Info& info) throw()
+		{
+			if ((info.type != TYPE_INES && info.type != TYPE_UNIF) || !info.hash)
+				return false;
+
+			Machine::FavoredSystem favored;
+
+			switch (info.system)
+			{
+				case Cartridge::Profile::System::NES_PAL:
+				case Cartridge::Profile::System::NES_PAL_A:
+				case Cartridge::Profile::System::NES_PAL_B: favored = Machine::FAVORED_NES_PAL; break;
+				case Cartridge::Profile::System::FAMICOM:   favored = Machine::FAVORED_FAMICOM; break;
+				case Cartridge::Profile::System::DENDY:     favored = Machine::FAVORED_DENDY;   break;
+				default:                                    favored = Machine::FAVORED_NES_NTSC; break;
+			}
+
+			const Cartridge::Database::Entry entry( database.FindEntry( info.hash, favored ) );
+
+			if (!entry)
+				return false;
+
+			try
+			{
+				info.title = entry.GetTitle();
+			}
+			catch (...)
+			{
+				return false;
+			}
+
+			info.system = entry.GetSystem();
+			info.mapper = entry.GetMapper();
+			info.prgRom = entry.GetPrgRom();
+			info.chrRom = entry.GetChrRom();
+			info.matched = true;
+
+			return true;
+		}
+
+		struct Scanner::Index::Entries
+		{
+			enum
+			{
+				ID = Core::AsciiId<'N','L','I'>::V | 0x1AUL << 24,
+				VERSION = 1,
+				MAX_NAME = 0xFFFF
+			};
+
+			struct Less
+			{
+				bool operator () (const Entry& a,const char* b) const
+				{
+					return std::strcmp( a.file.c_str(), b ) < 0;
+				}
+			};
+
+			typedef std::vector<Entry> List;
+
+			List list;
+
+			List::iterator Search(const char* file)
+			{
+				return std::lower_bound( list.begin(), list.end(), file, Less() );
+			}
+		};
+
+		Scanner::Index::Index() throw()
+		: entries(new (std::nothrow) Entries) {}
+
+		Scanner::Index::~Index() throw()
+		{
+			delete entries;
+		}
+
+		Result Scanner::Index::Load(std::istream& stdStream) throw()
+		{
+			if (!entries)
+				return RESULT_ERR_OUT_OF_MEMORY;
+
+			entries->list.clear();
+
+			try
+			{
+				Core::Stream::In stream( &stdStream );
+
+				if (stream.Read32() != Entries::ID || stream.Read8() != Entries::VERSION)
+					return RESULT_ERR_INVALID_FILE;
+
+				entries->list.resize( stream.Read32() );
+
+				for (Entries::List::iterator it(entries->list.begin()), end(entries->list.end()); it != end; ++it)
+				{
+					it->file.resize( stream.Read16() );
+
+					if (!it->file.empty())
+						stream.Read( reinterpret_cast<byte*>(&it->file[0]), it->file.size() );
+
+					it->size = static_cast<ulong>(stream.Read64());
+					it->time = static_cast<ulong>(stream.Read64());
+
+					Info& info = it->info;
+
+					info.type = static_cast<Type>(stream.Read8());
+					info.system = static_cast<Cartridge::Profile::System::Type>(stream.Read8());
+					info.mapper = stream.Read16();
+					info.subMapper = stream.Read8();
+					info.prgRom = stream.Read32();
+					info.chrRom = stream.Read32();
+
+					dword sha1[Cartridge::Profile::Hash::SHA1_WORD_LENGTH];
+					const dword crc = stream.Read32();
+
+					for (uint i=0; i < Cartridge::Profile::Hash::SHA1_WORD_LENGTH; ++i)
+						sha1[i] = stream.Read32();
+
+					info.hash.Assign( sha1, crc );
+					info.matched = stream.Read8();
+					info.title.resize( stream.Read16() );
+
+					for (std::wstring::iterator c(info.title.begin()), e(info.title.end()); c != e; ++c)
+						*c = stream.Read16();
+				}
+			}
+			catch (Result result)
+			{
+				entries->list.clear();
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				entries->list.clear();
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				entries->list.clear();
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Scanner::Index::Save(std::ostream& stdStream) const throw()
+		{
+			if (!entries)
+				return RESULT_ERR_OUT_OF_MEMORY;
+
+			try
+			{
+				Core::Stream::Out stream( &stdStream );
+
+				stream.Write32( Entries::ID );
+				stream.Write8( Entries::VERSION );
+				stream.Write32( entries->list.size() );
+
+				for (Entries::List::const_iterator it(entries->list.begin()), end(entries->list.end()); it != end; ++it)
+				{
+					stream.Write16( it->file.size() );
+
+					if (!it->file.empty())
+						stream.Write( reinterpret_cast<const byte*>(it->file.data()), it->file.size() );
+
+					stream.Write64( it->size );
+					stream.Write64( it->time );
+
+					const Info& info = it->info;
+
+					stream.Write8( info.type );
+					stream.Write8( info.system );
+					stream.Write16( info.mapper );
+					stream.Write8( info.subMapper );
+					stream.Write32( info.prgRom );
+					stream.Write32( info.chrRom );
+					stream.Write32( info.hash.GetCrc32() );
+
+					for (uint i=0; i < Cartridge::Profile::Hash::SHA1_WORD_LENGTH; ++i)
+						stream.Write32( info.hash.GetSha1()[i] );
+
+					stream.Write8( info.matched );
+
+					const std::wstring::size_type length = NST_MIN(info.title.size(),std::wstring::size_type(Entries::MAX_NAME));
+					stream.Write16( length );
+
+					for (std::wstring::size_type i=0; i < length; ++i)
+						stream.Write16( info.title[i] );
+				}
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Scanner::Index::Insert(const char* file,ulong size,ulong time,const Info& info) throw()
+		{
+			if (!file || std::strlen( file ) > Entries::MAX_NAME)
+				return RESULT_ERR_INVALID_PARAM;
+
+			if (!entries)
+				return RESULT_ERR_OUT_OF_MEMORY;
+
+			try
+			{
+				Entries::List::iterator it( entries->Search( file ) );
+
+				if (it == entries->list.end() || it->file != file)
+				{
+					it = entries->list.insert( it, Entry() );
+					it->file = file;
+				}
+
+				it->size = size;
+				it->time = time;
+				it->info = info;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+
+			return RESULT_OK;
+		}
+
+		const Scanner::Index::Entry* Scanner::Index::Find(const char* file) const throw()
+		{
+			if (entries && file)
+			{
+				const Entries::List::iterator it( entries->Search( file ) );
+
+				if (it != entries->list.end() && it->file == file)
+					return &*it;
+			}
+
+			return NULL;
+		}
+
+		const Scanner::Index::Entry* Scanner::Index::GetEntry(ulong i) const throw()
+		{
+			return entries && i < entries->list.size() ? &entries->list[i] : NULL;
+		}
+
+		void Scanner::Index::Clear() throw()
+		{
+			if (entries)
+				entries->list.clear();
+		}
+
+		ulong Scanner::Index::NumEntries() const throw()
+		{
+			return entries ? entries->list.size() : 0;
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
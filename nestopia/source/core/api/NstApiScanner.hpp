@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef NST_API_SCANNER_H
+#define NST_API_SCANNER_H
+
+#include <iosfwd>
+#include <string>
+#include "NstApiCartridge.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_ICC >= 810
+#pragma warning( push )
+#pragma warning( disable : 304 444 )
+#elif NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Api
+	{
+		/**
+		* Image library scanner.
+		*
+		* Identifies image files without loading them into an emulator. Only the file
+		* headers are parsed and the ROM data hashed, no machine or board is created,
+		* so any number of files can be scanned in parallel. The results are kept in
+		* an index a frontend can save and load back at startup in place of rescanning.
+		*/
+		class Scanner
+		{
+		public:
+
+			/**
+			* Image file type.
+			*/
+			enum Type
+			{
+				/**
+				* Unrecognized file.
+				*/
+				TYPE_UNKNOWN,
+				/**
+				* iNES or NES 2.0 file.
+				*/
+				TYPE_INES,
+				/**
+				* UNIF file.
+				*/
+				TYPE_UNIF,
+				/**
+				* Famicom Disk System image.
+				*/
+				TYPE_FDS,
+				/**
+				* NES Sound Format file.
+				*/
+				TYPE_NSF
+			};
+
+			/**
+			* Image information.
+			*/
+			struct Info
+			{
+				Info() throw();
+
+				/**
+				* Clears all information.
+				*/
+				void Clear() throw();
+
+				/**
+				* File type.
+				*/
+				Type type;
+
+				/**
+				* Target system.
+				*/
+				Cartridge::Profile::System::Type system;
+
+				/**
+				* Mapper ID, 0 if not given by the file or the database.
+				*/
+				uint mapper;
+
+				/**
+				* Sub-mapper ID.
+				*/
+				uint subMapper;
+
+				/**
+				* PRG-ROM size, or size of the disk or sound data.
+				*/
+				dword prgRom;
+
+				/**
+				* CHR-ROM size.
+				*/
+				dword chrRom;
+
+				/**
+				* Hash of PRG-ROM and CHR-ROM combined, or of the disk or sound data.
+				*/
+				Cartridge::Profile::Hash hash;
+
+				/**
+				* Title from the file or the database, may be empty.
+				*/
+				std::wstring title;
+
+				/**
+				* Set if the image was found in the database.
+				*/
+				bool matched;
+			};
+
+			/**
+			* Identifies an image file.
+			*
+			* Thread-safe, the stream is the only state touched. Pass false for hash if
+			* the hash is already known, for instance from a Scanner::Index, and
+			* only the headers will be read.
+			*
+			* @param stream input stream positioned at the start of the file
+			* @param info object to be filled
+			* @param hash true to hash the ROM data, default is true
+			* @return result code
+			*/
+			static Result Read(std::istream& stream,Info& info,bool hash=true) throw();
+
+			/**
+			* Matches an identified image against a database.
+			*
+			* Fills in the title, system, mapper and ROM sizes of the database entry.
+			* Database lookups are not thread-safe, run them after the files are read.
+			*
+			* @param database database to search
+			* @param info image information with its hash filled in
+			* @return true if found
+			*/
+			static bool Match(const Cartridge::Database& database,Info& info) throw();
+
+		private:
+
+			class Reader;
+
+		public:
+
+			/**
+			* Library index.
+			*
+			* Holds the information of every scanned file by name, size and modification
+			* time. The saved form is a flat binary file that is read back in one pass.
+			* Lookups may run in parallel but changes must be serialized by the caller.
+			*/
+			class Index
+			{
+			public:
+
+				Index() throw();
+				~Index() throw();
+
+				/**
+				* Index entry.
+				*/
+				struct Entry
+				{
+					/**
+					* File name.
+					*/
+					std::string file;
+
+					/**
+					* File size.
+					*/
+					ulong size;
+
+					/**
+					* File modification time.
+					*/
+					ulong time;
+
+					/**
+					* Image information.
+					*/
+					Info info;
+				};
+
+				/**
+				* Loads a previously saved index, replacing the current entries.
+				*
+				* @param stream input stream
+				* @return result code
+				*/
+				Result Load(std::istream& stream) throw();
+
+				/**
+				* Saves the index.
+				*
+				* @param stream output stream
+				* @return result code
+				*/
+				Result Save(std::ostream& stream) const throw();
+
+				/**
+				* Adds or updates the entry of a file.
+				*
+				* @param file file name
+				* @param size file size
+				* @param time file modification time
+				* @param info image information
+				* @return result code
+				*/
+				Result Insert(const char* file,ulong size,ulong time,const Info& info) throw();
+
+				/**
+				* Looks up the entry of a file.
+				*
+				* @param file file name
+				* @return entry or NULL if not found
+				*/
+				const Entry* Find(const char* file) const throw();
+
+				/**
+				* Returns an entry, sorted by file name.
+				*
+				* @param i index of entry
+				* @return entry or NULL if out of range
+				*/
+				const Entry* GetEntry(ulong i) const throw();
+
+				/**
+				* Removes all entries.
+				*/
+				void Clear() throw();
+
+				/**
+				* Returns the number of entries.
+				*
+				* @return number of entries
+				*/
+				ulong NumEntries() const throw();
+
+			private:
+
+				Index(const Index&);
+				Index& operator = (const Index&);
+
+				struct Entries;
+				Entries* const entries;
+			};
+		};
+	}
+}
+
+#if NST_MSVC >= 1200 || NST_ICC >= 810
+#pragma warning( pop )
+#endif
+
+#endif
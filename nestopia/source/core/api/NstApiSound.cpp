@@ -22,9 +22,15 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
+#include <new>
 #include "../NstMachine.hpp"
 #include "NstApiSound.hpp"
 
+#if NST_MSVC
+#include <intrin.h>
+#endif
+
 namespace Nes
 {
 	#ifdef NST_MSVC_OPTIMIZE
@@ -37,6 +43,236 @@ namespace Nes
 		{
 			Output::Locker Output::lockCallback;
 			Output::Unlocker Output::unlockCallback;
+
+			// Each side only ever writes its own position and reads the other one's,
+			// so an acquire/release pair on the positions is all the ring needs.
+
+			static inline dword LoadAcquire(const volatile dword& pos)
+			{
+			#ifdef __ATOMIC_ACQUIRE
+				return __atomic_load_n( &pos, __ATOMIC_ACQUIRE );
+			#else
+				const dword value = pos;
+				#if NST_MSVC
+				_ReadWriteBarrier();
+				#endif
+				return value;
+			#endif
+			}
+
+			static inline void StoreRelease(volatile dword& pos,const dword value)
+			{
+			#ifdef __ATOMIC_RELEASE
+				__atomic_store_n( &pos, value, __ATOMIC_RELEASE );
+			#else
+				#if NST_MSVC
+				_ReadWriteBarrier();
+				#endif
+				pos = value;
+			#endif
+			}
+
+			Ring::Ring()
+			:
+			data      (NULL),
+			mask      (0),
+			shift     (0),
+			silence   (0),
+			writePos  (0),
+			maxFilled (0),
+			overruns  (0),
+			readPos   (0),
+			minFilled (0),
+			underruns (0)
+			{
+			}
+
+			Ring::~Ring()
+			{
+				delete [] data;
+			}
+
+			Result Ring::SetFormat(uint length,uint bits,uint channels) throw()
+			{
+				if (!length || length > MAX_LENGTH || (bits != 8 && bits != 16) || (channels != 1 && channels != 2))
+					return RESULT_ERR_INVALID_PARAM;
+
+				uint size = 1;
+
+				while (size < length)
+					size <<= 1;
+
+				const uint bytes = (bits == 16) + (channels == 2);
+
+				uchar* const next = new (std::nothrow) uchar [size << bytes];
+
+				if (!next)
+					return RESULT_ERR_OUT_OF_MEMORY;
+
+				delete [] data;
+				data = next;
+				mask = size - 1;
+				shift = bytes;
+				silence = (bits == 16 ? 0x00 : 0x80);
+
+				Clear();
+
+				return RESULT_OK;
+			}
+
+			void Ring::Clear() throw()
+			{
+				writePos = 0;
+				readPos = 0;
+
+				ResetStats();
+			}
+
+			void Ring::ResetStats() throw()
+			{
+				maxFilled = 0;
+				overruns = 0;
+				minFilled = data ? mask + 1 : 0;
+				underruns = 0;
+			}
+
+			inline uint Ring::Free() const
+			{
+				return (mask + 1) - dword(writePos - LoadAcquire( readPos ));
+			}
+
+			bool Ring::Lock(Output& output,uint length) throw()
+			{
+				if (!data)
+					return false;
+
+				const uint free = Free();
+
+				if (length > free)
+				{
+					length = free;
+					++overruns;
+				}
+
+				if (!length)
+					return false;
+
+				const uint start = writePos & mask;
+				const uint chunk = mask + 1 - start;
+
+				output.samples[0] = data + (start << shift);
+
+				if (length <= chunk)
+				{
+					output.length[0] = length;
+					output.samples[1] = NULL;
+					output.length[1] = 0;
+				}
+				else
+				{
+					output.length[0] = chunk;
+					output.samples[1] = data;
+					output.length[1] = length - chunk;
+				}
+
+				return true;
+			}
+
+			void Ring::Unlock(const Output& output) throw()
+			{
+				NST_ASSERT( output.length[0] + output.length[1] <= Free() );
+
+				const dword pos = writePos + output.length[0] + output.length[1];
+				StoreRelease( writePos, pos );
+
+				const ulong filled = dword(pos - LoadAcquire( readPos ));
+
+				if (maxFilled < filled)
+					maxFilled = filled;
+			}
+
+			uint Ring::Write(const void* const samples,uint length) throw()
+			{
+				if (!data)
+					return 0;
+
+				const uint free = Free();
+
+				if (length > free)
+				{
+					length = free;
+					++overruns;
+				}
+
+				if (length)
+				{
+					const uint start = writePos & mask;
+					const uint chunk = NST_MIN(length,mask + 1 - start);
+
+					std::memcpy( data + (start << shift), samples, chunk << shift );
+					std::memcpy( data, static_cast<const uchar*>(samples) + (chunk << shift), (length - chunk) << shift );
+
+					const dword pos = writePos + length;
+					StoreRelease( writePos, pos );
+
+					const ulong filled = dword(pos - LoadAcquire( readPos ));
+
+					if (maxFilled < filled)
+						maxFilled = filled;
+				}
+
+				return length;
+			}
+
+			uint Ring::Read(void* const samples,const uint length) throw()
+			{
+				if (!data)
+					return 0;
+
+				const uint filled = dword(LoadAcquire( writePos ) - readPos);
+
+				if (minFilled > filled)
+					minFilled = filled;
+
+				uint count = length;
+
+				if (count > filled)
+				{
+					count = filled;
+					++underruns;
+				}
+
+				if (count)
+				{
+					const uint start = readPos & mask;
+					const uint chunk = NST_MIN(count,mask + 1 - start);
+
+					std::memcpy( samples, data + (start << shift), chunk << shift );
+					std::memcpy( static_cast<uchar*>(samples) + (chunk << shift), data, (count - chunk) << shift );
+
+					StoreRelease( readPos, readPos + count );
+				}
+
+				if (count < length)
+					std::memset( static_cast<uchar*>(samples) + (count << shift), silence, (length - count) << shift );
+
+				return count;
+			}
+
+			uint Ring::GetFilled() const throw()
+			{
+				return dword(LoadAcquire( writePos ) - LoadAcquire( readPos ));
+			}
+
+			void Ring::GetStats(Stats& stats) const throw()
+			{
+				stats.capacity = data ? mask + 1 : 0;
+				stats.filled = GetFilled();
+				stats.minFilled = minFilled;
+				stats.maxFilled = maxFilled;
+				stats.underruns = underruns;
+				stats.overruns = overruns;
+			}
 		}
 	}
 
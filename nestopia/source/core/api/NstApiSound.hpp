@@ -150,6 +150,172 @@ namespace Nes
 						function( userdata, output );
 				}
 			};
+
+			/**
+			* Lock-free sound ring buffer.
+			*
+			* Single-producer/single-consumer FIFO for handing samples from the emulation
+			* thread over to an audio device callback without a mutex. The producer plugs
+			* it into the sound lock/unlock callbacks through Lock() and Unlock(), the
+			* consumer drains it with Read(). All lengths are in <b>number of</b> samples,
+			* same as for Output, so a stereo sample spans both speakers.
+			*/
+			class Ring
+			{
+			public:
+
+				Ring();
+				~Ring();
+
+				enum
+				{
+					MAX_LENGTH = 0x100000
+				};
+
+				/**
+				* Fill-level telemetry.
+				*/
+				struct Stats
+				{
+					/**
+					* Total number of samples the ring can hold.
+					*/
+					ulong capacity;
+
+					/**
+					* Number of samples currently queued.
+					*/
+					ulong filled;
+
+					/**
+					* Lowest fill level seen by the consumer since the last reset.
+					*/
+					ulong minFilled;
+
+					/**
+					* Highest fill level seen by the producer since the last reset.
+					*/
+					ulong maxFilled;
+
+					/**
+					* Number of reads that ran dry and were padded with silence.
+					*/
+					ulong underruns;
+
+					/**
+					* Number of writes that didn't fit and were truncated.
+					*/
+					ulong overruns;
+				};
+
+				/**
+				* Allocates the ring.
+				*
+				* Must not be called while either side is active.
+				*
+				* @param length minimum capacity, rounded up to the nearest power of two
+				* @param bits sample bits, 8 or 16
+				* @param channels 1 for mono or 2 for stereo
+				* @return result code
+				*/
+				Result SetFormat(uint length,uint bits,uint channels) throw();
+
+				/**
+				* Discards all queued samples and resets the telemetry.
+				*
+				* Must not be called while either side is active.
+				*/
+				void Clear() throw();
+
+				/**
+				* Producer side, maps free space into a sound output context.
+				*
+				* Meant to be called from the sound lock callback. The two output
+				* buffers are pointed at the free space, wrapping around if needed.
+				*
+				* @param output sound output context
+				* @param length number of samples to be rendered for this frame
+				* @return false if the ring is full
+				*/
+				bool Lock(Output& output,uint length) throw();
+
+				/**
+				* Producer side, publishes samples rendered after a call to Lock().
+				*
+				* @param output sound output context
+				*/
+				void Unlock(const Output& output) throw();
+
+				/**
+				* Producer side, copies samples in.
+				*
+				* @param samples source samples
+				* @param length number of samples
+				* @return number of samples actually written
+				*/
+				uint Write(const void* samples,uint length) throw();
+
+				/**
+				* Consumer side, copies samples out.
+				*
+				* Missing samples are filled with silence.
+				*
+				* @param samples destination samples
+				* @param length number of samples
+				* @return number of queued samples actually read
+				*/
+				uint Read(void* samples,uint length) throw();
+
+				/**
+				* Returns the number of queued samples.
+				*
+				* @return number
+				*/
+				uint GetFilled() const throw();
+
+				/**
+				* Returns the telemetry.
+				*
+				* @param stats object to be filled in
+				*/
+				void GetStats(Stats& stats) const throw();
+
+				/**
+				* Resets the underrun/overrun counters and watermarks.
+				*/
+				void ResetStats() throw();
+
+			private:
+
+				Ring(const Ring&);
+				void operator = (const Ring&);
+
+				uint Free() const;
+
+				enum
+				{
+					CACHE_LINE = 64
+				};
+
+				uchar* data;
+				uint mask;
+				uint shift;
+				uint silence;
+
+				char pad0[CACHE_LINE];
+
+				volatile dword writePos;
+				ulong maxFilled;
+				ulong overruns;
+
+				char pad1[CACHE_LINE];
+
+				volatile dword readPos;
+				ulong minFilled;
+				ulong underruns;
+
+				char pad2[CACHE_LINE];
+			};
 		}
 	}
 
@@ -393,6 +559,11 @@ namespace Nes
 			* Sound output context.
 			*/
 			typedef Core::Sound::Output Output;
+
+			/**
+			* Lock-free sound ring buffer.
+			*/
+			typedef Core::Sound::Ring Ring;
 		};
 	}
 }
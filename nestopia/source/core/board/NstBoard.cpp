@@ -193,7 +193,7 @@ namespace Nes
 
 				const dword oldPrg = prgRom.Size();
 
-				prgRom.Set( Ram::ROM, true, false, NST_MIN(oldPrg,GetMaxPrg()) );
+				prgRom.Set( Ram::ROM, true, false, NST_MIN(oldPrg,GetMaxPrg()), prgRom.Internal() ? NULL : prgRom.Mem() );
 				prgRom.Mirror( SIZE_16K );
 
 				if (prgRom.Size() != oldPrg)
@@ -219,7 +219,7 @@ namespace Nes
 
 				const dword oldChr = chrRom.Size();
 
-				chrRom.Set( Ram::ROM, true, false, NST_MIN(oldChr,GetMaxChr()) );
+				chrRom.Set( Ram::ROM, true, false, NST_MIN(oldChr,GetMaxChr()), chrRom.Internal() ? NULL : chrRom.Mem() );
 
 				if (chrRom.Size())
 					chrRom.Mirror( SIZE_8K );
@@ -319,12 +319,13 @@ namespace Nes
 
 			Board::Board(const Context& context)
 			:
-			cpu   (*context.cpu),
-			ppu   (*context.ppu),
-			chr   (context.ppu->GetChrMem()),
-			nmt   (context.ppu->GetNmtMem()),
-			vram  (Ram::RAM,true,true,context.type.GetVram()),
-			board (context.type)
+			cpu       (*context.cpu),
+			ppu       (*context.ppu),
+			chr       (context.ppu->GetChrMem()),
+			nmt       (context.ppu->GetNmtMem()),
+			vram      (Ram::RAM,true,true,context.type.GetVram()),
+			board     (context.type),
+			directPrg (false)
 			{
 				prg.Source(0).Set( context.prg );
 
@@ -441,6 +442,19 @@ namespace Nes
 				}
 
 				SubReset( hard );
+
+				if (directPrg)
+				{
+					const Io::Port ports[4] =
+					{
+						Io::Port( this, &Board::Peek_Prg_8, &Board::Poke_Nop ),
+						Io::Port( this, &Board::Peek_Prg_A, &Board::Poke_Nop ),
+						Io::Port( this, &Board::Peek_Prg_C, &Board::Poke_Nop ),
+						Io::Port( this, &Board::Peek_Prg_E, &Board::Poke_Nop )
+					};
+
+					cpu.SetPrgPages( prg.GetPages(), ports );
+				}
 			}
 
 			void Board::Save(File& file) const
@@ -3308,390 +3322,519 @@ namespace Nes
 				return true;
 			}
 
+			// Boards are looked up in a table rather than a switch so that a build
+			// can leave out whole families by defining NST_NO_BOARDS_<FAMILY> and
+			// not compiling their sources other than the shared ones listed in
+			// NstApiConfig.hpp. Boards built separately, such as a module loaded
+			// on demand, are added with Register().
+
+			const Board::Entry Board::entries[] =
+			{
+				{ Type::STD_NROM                , &Board::MakeDirect<NRom> },
+				{ Type::UNL_NROM                , &Board::MakeDirect<NRom> },
+				{ Type::STD_AMROM               , &Board::MakeDirect<AxRom> },
+				{ Type::STD_ANROM               , &Board::MakeDirect<AxRom> },
+				{ Type::STD_AN1ROM              , &Board::MakeDirect<AxRom> },
+				{ Type::STD_AOROM               , &Board::MakeDirect<AxRom> },
+				{ Type::UNL_AXROM               , &Board::MakeDirect<AxRom> },
+				{ Type::STD_BNROM               , &Board::Make<BxRom> },
+				{ Type::UNL_BXROM               , &Board::Make<BxRom> },
+				{ Type::STD_CNROM               , &Board::MakeDirect<CnRom> },
+				{ Type::STD_CXROM               , &Board::MakeDirect<CnRom> },
+				{ Type::UNL_CXROM               , &Board::MakeDirect<CnRom> },
+				{ Type::STD_CPROM               , &Board::Make<CpRom> },
+				{ Type::STD_DEROM               , &Board::Make<DxRom> },
+				{ Type::STD_DE1ROM              , &Board::Make<DxRom> },
+				{ Type::STD_DRROM               , &Board::Make<DxRom> },
+				{ Type::STD_EKROM               , &Board::Make<ExRom> },
+				{ Type::STD_ELROM               , &Board::Make<ExRom> },
+				{ Type::STD_ETROM               , &Board::Make<ExRom> },
+				{ Type::STD_EWROM               , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_0             , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_1             , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_2             , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_3             , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_4             , &Board::Make<ExRom> },
+				{ Type::STD_EXROM_5             , &Board::Make<ExRom> },
+				{ Type::STD_FJROM               , &Board::Make<FxRom> },
+				{ Type::STD_FKROM               , &Board::Make<FxRom> },
+				{ Type::STD_GNROM               , &Board::Make<GxRom> },
+				{ Type::UNL_GXROM               , &Board::Make<GxRom> },
+				{ Type::STD_MHROM               , &Board::Make<MxRom> },
+				{ Type::STD_HKROM               , &Board::Make<HxRom> },
+				{ Type::STD_JLROM               , &Board::Make<JxRom> },
+				{ Type::STD_JSROM               , &Board::Make<JxRom> },
+				{ Type::STD_NTBROM              , &Board::Make<NxRom> },
+				{ Type::STD_PEEOROM             , &Board::Make<PxRom> },
+				{ Type::STD_PNROM               , &Board::Make<PxRom> },
+				{ Type::STD_PNROM_PC10          , &Board::Make<PxRom> },
+				{ Type::STD_SAROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SBROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SCROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SEROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SFROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SGROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SHROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SJROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SKROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SLROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SNROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SOROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SUROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_SXROM               , &Board::MakeDirect<SxRom> },
+				{ Type::STD_TBROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TEROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TFROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TGROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TKROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TLROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TNROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TR1ROM              , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TSROM               , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TVROM               , &Board::MakeDirect<TxRom> },
+				{ Type::UNL_TRXROM              , &Board::MakeDirect<TxRom> },
+				{ Type::STD_TLSROM              , &Board::Make<TlsRom> },
+				{ Type::STD_TKSROM              , &Board::Make<TksRom> },
+				{ Type::STD_TQROM               , &Board::Make<TqRom> },
+				{ Type::STD_UNROM               , &Board::MakeDirect<UxRom> },
+				{ Type::STD_UN1ROM              , &Board::MakeDirect<UxRom> },
+				{ Type::STD_UOROM               , &Board::MakeDirect<UxRom> },
+				{ Type::STD_UXROM               , &Board::MakeDirect<UxRom> },
+				{ Type::UNL_UXROM               , &Board::MakeDirect<UxRom> },
+				#ifndef NST_NO_BOARDS_DISCRETE
+				{ Type::DISCRETE_74_377         , &Board::Make<Discrete::Ic74x377> },
+				{ Type::DISCRETE_74_139_74      , &Board::Make<Discrete::Ic74x139x74> },
+				{ Type::DISCRETE_74_161_138     , &Board::Make<Discrete::Ic74x161x138> },
+				{ Type::DISCRETE_74_161_161_32_A, &Board::Make<Discrete::Ic74x161x161x32> },
+				{ Type::DISCRETE_74_161_161_32_B, &Board::Make<Discrete::Ic74x161x161x32> },
+				#endif
+				{ Type::CUSTOM_B4               , &Board::MakeDirect<TxRom> },
+				{ Type::CUSTOM_BTR              , &Board::Make<JxRom> },
+				{ Type::CUSTOM_EVENT            , &Board::Make<Boards::Event> },
+				{ Type::CUSTOM_FFE3             , &Board::Make<Ffe> },
+				{ Type::CUSTOM_FFE4             , &Board::Make<Ffe> },
+				{ Type::CUSTOM_FFE8             , &Board::Make<Ffe> },
+				{ Type::CUSTOM_FB02             , &Board::Make<Fb> },
+				{ Type::CUSTOM_FB04             , &Board::Make<Fb> },
+				{ Type::CUSTOM_RUMBLESTATION    , &Board::Make<RumbleStation> },
+				{ Type::CUSTOM_QJ               , &Board::Make<Qj> },
+				{ Type::CUSTOM_VSSYSTEM_0       , &Board::Make<VsSystem> },
+				{ Type::CUSTOM_VSSYSTEM_1       , &Board::Make<VsSystem> },
+				{ Type::CUSTOM_WH               , &Board::MakeDirect<SxRom> },
+				{ Type::CUSTOM_X79B             , &Board::MakeDirect<CnRom> },
+				{ Type::CUSTOM_ZZ               , &Board::Make<Zz> },
+				#ifndef NST_NO_BOARDS_ACCLAIM
+				{ Type::ACCLAIM_MCACC           , &Board::Make<Acclaim::McAcc> },
+				#endif
+				#ifndef NST_NO_BOARDS_AE
+				{ Type::AE_STD                  , &Board::Make<Ae::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_AGCI
+				{ Type::AGCI_50282              , &Board::Make<Agci::A50282> },
+				#endif
+				#ifndef NST_NO_BOARDS_AVE
+				{ Type::AVE_MB_91               , &Board::Make<Ave::Mb91> },
+				{ Type::AVE_NINA001             , &Board::Make<Ave::Nina001> },
+				{ Type::AVE_NINA002             , &Board::Make<Ave::Nina002> },
+				{ Type::AVE_NINA03              , &Board::Make<Ave::Nina03> },
+				{ Type::AVE_NINA06              , &Board::Make<Ave::Nina06> },
+				{ Type::AVE_NINA07              , &Board::Make<Ave::Nina07> },
+				{ Type::AVE_D1012               , &Board::Make<Ave::D1012> },
+				#endif
+				#ifndef NST_NO_BOARDS_BANDAI
+				{ Type::BANDAI_FCG1             , &Board::Make<Bandai::Fcg1> },
+				{ Type::BANDAI_FCG2             , &Board::Make<Bandai::Fcg2> },
+				{ Type::BANDAI_BAJUMP2          , &Board::Make<Bandai::Lz93d50> },
+				{ Type::BANDAI_LZ93D50_24C01    , &Board::Make<Bandai::Lz93d50Ex> },
+				{ Type::BANDAI_LZ93D50_24C02    , &Board::Make<Bandai::Lz93d50Ex> },
+				{ Type::BANDAI_DATACH           , &Board::Make<Bandai::Datach> },
+				{ Type::BANDAI_KARAOKESTUDIO    , &Board::Make<Bandai::KaraokeStudio> },
+				{ Type::BANDAI_AEROBICSSTUDIO   , &Board::Make<Bandai::AerobicsStudio> },
+				{ Type::BANDAI_OEKAKIDS         , &Board::Make<Bandai::OekaKids> },
+				#endif
+				#ifndef NST_NO_BOARDS_BMC
+				{ Type::BMC_BALLGAMES_11IN1     , &Board::Make<Bmc::Ballgames11in1> },
+				{ Type::BMC_A65AS               , &Board::Make<Bmc::A65as> },
+				{ Type::BMC_CTC65               , &Board::Make<Bmc::Ctc65> },
+				#endif
+				#ifndef NST_NO_BOARDS_CONY
+				{ Type::BMC_DRAGONBOLLPARTY     , &Board::Make<Cony::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_BMC
+				{ Type::BMC_110IN1              , &Board::Make<Bmc::B110in1> },
+				{ Type::BMC_1200IN1             , &Board::Make<Bmc::B1200in1> },
+				{ Type::BMC_150IN1              , &Board::Make<Bmc::B150in1> },
+				{ Type::BMC_15IN1               , &Board::Make<Bmc::B15in1> },
+				{ Type::BMC_20IN1               , &Board::Make<Bmc::B20in1> },
+				{ Type::BMC_21IN1               , &Board::Make<Bmc::B21in1> },
+				{ Type::BMC_22GAMES             , &Board::Make<Bmc::B22Games> },
+				{ Type::BMC_31IN1               , &Board::Make<Bmc::B31in1> },
+				{ Type::BMC_35IN1               , &Board::Make<Bmc::B35in1> },
+				{ Type::BMC_36IN1               , &Board::Make<Bmc::B36in1> },
+				{ Type::BMC_64IN1               , &Board::Make<Bmc::B64in1> },
+				{ Type::BMC_72IN1               , &Board::Make<Bmc::B72in1> },
+				{ Type::BMC_76IN1               , &Board::Make<Bmc::B76in1> },
+				{ Type::BMC_SUPER_42IN1         , &Board::Make<Bmc::B76in1> },
+				{ Type::BMC_8157                , &Board::Make<Bmc::B8157> },
+				{ Type::BMC_9999999IN1          , &Board::Make<Bmc::B9999999in1> },
+				{ Type::BMC_FAMILY_4646B        , &Board::Make<Bmc::Family4646B> },
+				{ Type::BMC_FKC23C              , &Board::Make<Bmc::Fk23c> },
+				{ Type::BMC_GAME_800IN1         , &Board::Make<Bmc::Game800in1> },
+				{ Type::BMC_GOLDEN_190IN1       , &Board::Make<Bmc::Golden190in1> },
+				{ Type::BMC_GOLDENGAME_150IN1   , &Board::Make<Bmc::GoldenGame260in1> },
+				{ Type::BMC_GOLDENGAME_260IN1   , &Board::Make<Bmc::GoldenGame260in1> },
+				{ Type::BMC_GOLDENCARD_6IN1     , &Board::Make<Bmc::GoldenCard6in1> },
+				{ Type::BMC_GKA                 , &Board::Make<Bmc::GamestarA> },
+				{ Type::BMC_GKB                 , &Board::Make<Bmc::GamestarB> },
+				{ Type::BMC_HERO                , &Board::Make<Bmc::Hero> },
+				{ Type::BMC_MARIOPARTY_7IN1     , &Board::Make<Bmc::MarioParty7in1> },
+				{ Type::BMC_NOVELDIAMOND        , &Board::Make<Bmc::NovelDiamond> },
+				{ Type::BMC_CH001               , &Board::Make<Bmc::Ch001> },
+				{ Type::BMC_POWERJOY_84IN1      , &Board::Make<Bmc::Powerjoy84in1> },
+				{ Type::BMC_RESETBASED_4IN1     , &Board::Make<Bmc::ResetBased4in1> },
+				{ Type::BMC_VT5201              , &Board::Make<Bmc::Vt5201> },
+				{ Type::BMC_SUPER_24IN1         , &Board::Make<Bmc::Super24in1> },
+				{ Type::BMC_SUPER_22GAMES       , &Board::Make<Bmc::Super22Games> },
+				{ Type::BMC_SUPER_40IN1         , &Board::Make<Bmc::Super40in1> },
+				{ Type::BMC_SUPER_700IN1        , &Board::Make<Bmc::Super700in1> },
+				{ Type::BMC_SUPERBIG_7IN1       , &Board::Make<Bmc::SuperBig7in1> },
+				{ Type::BMC_SUPERGUN_20IN1      , &Board::Make<Bmc::SuperGun20in1> },
+				{ Type::BMC_SUPERHIK_4IN1       , &Board::Make<Bmc::SuperHiK4in1> },
+				{ Type::BMC_SUPERHIK_300IN1     , &Board::Make<Bmc::SuperHiK300in1> },
+				{ Type::BMC_SUPERVISION_16IN1   , &Board::Make<Bmc::SuperVision16in1> },
+				{ Type::BMC_T262                , &Board::Make<Bmc::T262> },
+				{ Type::BMC_VRC4                , &Board::Make<Bmc::Vrc4> },
+				{ Type::BMC_Y2K_64IN1           , &Board::Make<Bmc::Y2k64in1> },
+				#endif
+				#ifndef NST_NO_BOARDS_BTL
+				{ Type::BTL_AISENSHINICOL       , &Board::Make<Btl::MarioBaby> },
+				{ Type::BTL_MARIOBABY           , &Board::Make<Btl::MarioBaby> },
+				{ Type::BTL_2708                , &Board::Make<Btl::B2708> },
+				{ Type::BTL_AX5705              , &Board::Make<Btl::Ax5705> },
+				{ Type::BTL_6035052             , &Board::Make<Btl::B6035052> },
+				{ Type::BTL_DRAGONNINJA         , &Board::Make<Btl::DragonNinja> },
+				{ Type::BTL_GENIUSMERIOBROS     , &Board::Make<Btl::GeniusMerioBros> },
+				{ Type::BTL_SHUIGUANPIPE        , &Board::Make<Btl::ShuiGuanPipe> },
+				{ Type::BTL_PIKACHUY2K          , &Board::Make<Btl::PikachuY2k> },
+				{ Type::BTL_SMB2_A              , &Board::Make<Btl::Smb2a> },
+				{ Type::BTL_SMB2_B              , &Board::Make<Btl::Smb2b> },
+				{ Type::BTL_SMB2_C              , &Board::Make<Btl::Smb2c> },
+				{ Type::BTL_SMB3                , &Board::Make<Btl::Smb3> },
+				{ Type::BTL_SUPERBROS11         , &Board::Make<Btl::SuperBros11> },
+				{ Type::BTL_T230                , &Board::Make<Btl::T230> },
+				{ Type::BTL_TOBIDASEDAISAKUSEN  , &Board::Make<Btl::TobidaseDaisakusen> },
+				#endif
+				#ifndef NST_NO_BOARDS_CAMERICA
+				{ Type::CAMERICA_BF9093         , &Board::Make<Camerica::Bf9093> },
+				{ Type::CAMERICA_BF9096         , &Board::Make<Camerica::Bf9096> },
+				{ Type::CAMERICA_BF9097         , &Board::Make<Camerica::Bf9097> },
+				{ Type::CAMERICA_BF909X         , &Board::Make<Camerica::Bf9097> },
+				{ Type::CAMERICA_ALGNV11        , &Board::Make<Camerica::Algnv11> },
+				{ Type::CAMERICA_ALGQV11        , &Board::Make<Camerica::Algqv11> },
+				{ Type::CAMERICA_GOLDENFIVE     , &Board::Make<Camerica::GoldenFive> },
+				#endif
+				#ifndef NST_NO_BOARDS_CALTRON
+				{ Type::CALTRON_6IN1            , &Board::Make<Caltron::Mc6in1> },
+				#endif
+				#ifndef NST_NO_BOARDS_CNE
+				{ Type::CNE_SHLZ                , &Board::Make<Cne::Shlz> },
+				{ Type::CNE_DECATHLON           , &Board::Make<Cne::Decathlon> },
+				{ Type::CNE_PSB                 , &Board::Make<Cne::Psb> },
+				#endif
+				#ifndef NST_NO_BOARDS_CONY
+				{ Type::CONY_STD                , &Board::Make<Cony::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_DREAMTECH
+				{ Type::DREAMTECH_01            , &Board::Make<DreamTech::D01> },
+				#endif
+				#ifndef NST_NO_BOARDS_FUTUREMEDIA
+				{ Type::FUTUREMEDIA_STD         , &Board::Make<FutureMedia::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_FUJIYA
+				{ Type::FUJIYA_STD              , &Board::Make<Fujiya::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_FUKUTAKE
+				{ Type::FUKUTAKE_SBX            , &Board::Make<Fukutake::Sbx> },
+				#endif
+				#ifndef NST_NO_BOARDS_GOUDER
+				{ Type::GOUDER_37017            , &Board::Make<Gouder::G37017> },
+				#endif
+				#ifndef NST_NO_BOARDS_HES
+				{ Type::HES_STD                 , &Board::Make<Hes::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_BENSHENG
+				{ Type::BENSHENG_BS5            , &Board::Make<Bensheng::Bs5> },
+				#endif
+				#ifndef NST_NO_BOARDS_HENGGEDIANZI
+				{ Type::HENGEDIANZI_STD         , &Board::Make<Hengedianzi::Standard> },
+				{ Type::HENGEDIANZI_XJZB        , &Board::Make<Hengedianzi::Xjzb> },
+				#endif
+				#ifndef NST_NO_BOARDS_HOSENKAN
+				{ Type::HOSENKAN_STD            , &Board::Make<Hosenkan::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_IREM
+				{ Type::IREM_G101A_0            , &Board::Make<Irem::G101> },
+				{ Type::IREM_G101A_1            , &Board::Make<Irem::G101> },
+				{ Type::IREM_G101B_0            , &Board::Make<Irem::G101> },
+				{ Type::IREM_G101B_1            , &Board::Make<Irem::G101> },
+				{ Type::IREM_H3001              , &Board::Make<Irem::H3001> },
+				{ Type::IREM_LROG017            , &Board::Make<Irem::Lrog017> },
+				{ Type::IREM_HOLYDIVER          , &Board::Make<Irem::HolyDiver> },
+				{ Type::IREM_KAIKETSU           , &Board::Make<Irem::Kaiketsu> },
+				#endif
+				#ifndef NST_NO_BOARDS_JALECO
+				{ Type::JALECO_JF01             , &Board::Make<Jaleco::Jf01> },
+				{ Type::JALECO_JF02             , &Board::Make<Jaleco::Jf02> },
+				{ Type::JALECO_JF03             , &Board::Make<Jaleco::Jf03> },
+				{ Type::JALECO_JF04             , &Board::Make<Jaleco::Jf04> },
+				{ Type::JALECO_JF05             , &Board::Make<Jaleco::Jf05> },
+				{ Type::JALECO_JF06             , &Board::Make<Jaleco::Jf06> },
+				{ Type::JALECO_JF07             , &Board::Make<Jaleco::Jf07> },
+				{ Type::JALECO_JF08             , &Board::Make<Jaleco::Jf08> },
+				{ Type::JALECO_JF09             , &Board::Make<Jaleco::Jf09> },
+				{ Type::JALECO_JF10             , &Board::Make<Jaleco::Jf10> },
+				{ Type::JALECO_JF11             , &Board::Make<Jaleco::Jf11> },
+				{ Type::JALECO_JF12             , &Board::Make<Jaleco::Jf12> },
+				{ Type::JALECO_JF13             , &Board::Make<Jaleco::Jf13> },
+				{ Type::JALECO_JF14             , &Board::Make<Jaleco::Jf14> },
+				{ Type::JALECO_JF15             , &Board::Make<Jaleco::Jf15> },
+				{ Type::JALECO_JF16             , &Board::Make<Jaleco::Jf16> },
+				{ Type::JALECO_JF17             , &Board::Make<Jaleco::Jf17> },
+				{ Type::JALECO_JF18             , &Board::Make<Jaleco::Jf18> },
+				{ Type::JALECO_JF19             , &Board::Make<Jaleco::Jf19> },
+				{ Type::JALECO_JF20             , &Board::Make<Jaleco::Jf20> },
+				{ Type::JALECO_JF21             , &Board::Make<Jaleco::Jf21> },
+				{ Type::JALECO_JF22             , &Board::Make<Jaleco::Jf22> },
+				{ Type::JALECO_JF23             , &Board::Make<Jaleco::Jf23> },
+				{ Type::JALECO_JF24             , &Board::Make<Jaleco::Jf24> },
+				{ Type::JALECO_JF25             , &Board::Make<Jaleco::Jf25> },
+				{ Type::JALECO_JF26             , &Board::Make<Jaleco::Jf26> },
+				{ Type::JALECO_JF27             , &Board::Make<Jaleco::Jf27> },
+				{ Type::JALECO_JF28             , &Board::Make<Jaleco::Jf28> },
+				{ Type::JALECO_JF29             , &Board::Make<Jaleco::Jf29> },
+				{ Type::JALECO_JF30             , &Board::Make<Jaleco::Jf30> },
+				{ Type::JALECO_JF31             , &Board::Make<Jaleco::Jf31> },
+				{ Type::JALECO_JF32             , &Board::Make<Jaleco::Jf32> },
+				{ Type::JALECO_JF33             , &Board::Make<Jaleco::Jf33> },
+				{ Type::JALECO_JF34             , &Board::Make<Jaleco::Jf34> },
+				{ Type::JALECO_JF35             , &Board::Make<Jaleco::Jf35> },
+				{ Type::JALECO_JF36             , &Board::Make<Jaleco::Jf36> },
+				{ Type::JALECO_JF37             , &Board::Make<Jaleco::Jf37> },
+				{ Type::JALECO_JF38             , &Board::Make<Jaleco::Jf38> },
+				{ Type::JALECO_JF39             , &Board::Make<Jaleco::Jf39> },
+				{ Type::JALECO_JF40             , &Board::Make<Jaleco::Jf40> },
+				{ Type::JALECO_JF41             , &Board::Make<Jaleco::Jf41> },
+				{ Type::JALECO_SS88006          , &Board::Make<Jaleco::Ss88006> },
+				#endif
+				#ifndef NST_NO_BOARDS_JYCOMPANY
+				{ Type::JYCOMPANY_TYPE_A        , &Board::Make<JyCompany::Standard> },
+				{ Type::JYCOMPANY_TYPE_B        , &Board::Make<JyCompany::Standard> },
+				{ Type::JYCOMPANY_TYPE_C        , &Board::Make<JyCompany::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_KAISER
+				{ Type::KAISER_KS202            , &Board::Make<Kaiser::Ks202> },
+				{ Type::KAISER_KS7022           , &Board::Make<Kaiser::Ks7022> },
+				{ Type::KAISER_KS7032           , &Board::Make<Kaiser::Ks7032> },
+				{ Type::KAISER_KS7058           , &Board::Make<Kaiser::Ks7058> },
+				#endif
+				#ifndef NST_NO_BOARDS_KASING
+				{ Type::KASING_STD              , &Board::Make<Kasing::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_KAY
+				{ Type::KAY_H2288               , &Board::Make<Kay::H2288> },
+				{ Type::KAY_PANDAPRINCE         , &Board::Make<Kay::PandaPrince> },
+				#endif
+				#ifndef NST_NO_BOARDS_KONAMI
+				{ Type::KONAMI_VRC1             , &Board::Make<Konami::Vrc1> },
+				{ Type::KONAMI_VRC2             , &Board::Make<Konami::Vrc2> },
+				{ Type::KONAMI_VRC3             , &Board::Make<Konami::Vrc3> },
+				{ Type::KONAMI_VRC4_0           , &Board::Make<Konami::Vrc4> },
+				{ Type::KONAMI_VRC4_1           , &Board::Make<Konami::Vrc4> },
+				{ Type::KONAMI_VRC4_2           , &Board::Make<Konami::Vrc4> },
+				{ Type::KONAMI_VRC6_0           , &Board::Make<Konami::Vrc6> },
+				{ Type::KONAMI_VRC6_1           , &Board::Make<Konami::Vrc6> },
+				{ Type::KONAMI_VRC7_0           , &Board::Make<Konami::Vrc7> },
+				{ Type::KONAMI_VRC7_1           , &Board::Make<Konami::Vrc7> },
+				{ Type::KONAMI_VSSYSTEM         , &Board::Make<Konami::VsSystem> },
+				#endif
+				#ifndef NST_NO_BOARDS_MAGICSERIES
+				{ Type::MAGICSERIES_MAGICDRAGON , &Board::Make<MagicSeries::MagicDragon> },
+				#endif
+				#ifndef NST_NO_BOARDS_NAMCOT
+				{ Type::NAMCOT_3425             , &Board::Make<Namcot::N3425> },
+				{ Type::NAMCOT_3433             , &Board::Make<Namcot::N3433> },
+				{ Type::NAMCOT_3443             , &Board::Make<Namcot::N3443> },
+				{ Type::NAMCOT_3446             , &Board::Make<Namcot::N3446> },
+				{ Type::NAMCOT_34XX             , &Board::Make<Namcot::N34xx> },
+				{ Type::NAMCOT_163_0            , &Board::Make<Namcot::N163> },
+				{ Type::NAMCOT_163_1            , &Board::Make<Namcot::N163> },
+				{ Type::NAMCOT_163_S_0          , &Board::Make<Namcot::N163> },
+				{ Type::NAMCOT_163_S_1          , &Board::Make<Namcot::N163> },
+				{ Type::NAMCOT_340              , &Board::Make<Namcot::N175> },
+				{ Type::NAMCOT_175              , &Board::Make<Namcot::N175> },
+				#endif
+				#ifndef NST_NO_BOARDS_NANJING
+				{ Type::NANJING_STD             , &Board::Make<Nanjing::Standard> },
+				#endif
+				#ifndef NST_NO_BOARDS_NIHON
+				{ Type::UNL_UXROM_M5            , &Board::Make<Nihon::UnRomM5> },
+				{ Type::NIHON_UNROM_M5          , &Board::Make<Nihon::UnRomM5> },
+				#endif
+				#ifndef NST_NO_BOARDS_NITRA
+				{ Type::NITRA_TDA               , &Board::Make<Nitra::Tda> },
+				#endif
+				#ifndef NST_NO_BOARDS_NTDEC
+				{ Type::NTDEC_N715062           , &Board::Make<Ntdec::N715062> },
+				{ Type::NTDEC_ASDER_0           , &Board::Make<Ntdec::Asder> },
+				{ Type::NTDEC_ASDER_1           , &Board::Make<Ntdec::Asder> },
+				{ Type::NTDEC_FIGHTINGHERO      , &Board::Make<Ntdec::FightingHero> },
+				#endif
+				#ifndef NST_NO_BOARDS_OPENCORP
+				{ Type::OPENCORP_DAOU306        , &Board::Make<OpenCorp::Daou306> },
+				#endif
+				#ifndef NST_NO_BOARDS_REXSOFT
+				{ Type::REXSOFT_SL1632          , &Board::Make<RexSoft::Sl1632> },
+				{ Type::REXSOFT_DBZ5            , &Board::Make<RexSoft::Dbz5> },
+				#endif
+				#ifndef NST_NO_BOARDS_RCM
+				{ Type::RCM_GS2013              , &Board::Make<Rcm::Gs2013> },
+				{ Type::RCM_GS2015              , &Board::Make<Rcm::Gs2015> },
+				{ Type::RCM_GS2004              , &Board::Make<Rcm::Gs2004> },
+				{ Type::RCM_TETRISFAMILY        , &Board::Make<Rcm::TetrisFamily> },
+				#endif
+				#ifndef NST_NO_BOARDS_SACHEN
+				{ Type::SACHEN_8259A            , &Board::Make<Sachen::S8259> },
+				{ Type::SACHEN_8259B            , &Board::Make<Sachen::S8259> },
+				{ Type::SACHEN_8259C            , &Board::Make<Sachen::S8259> },
+				{ Type::SACHEN_8259D            , &Board::Make<Sachen::S8259> },
+				{ Type::SACHEN_TCA01            , &Board::Make<Sachen::Tca01> },
+				{ Type::SACHEN_TCU01            , &Board::Make<Sachen::Tcu01> },
+				{ Type::SACHEN_TCU02            , &Board::Make<Sachen::Tcu02> },
+				{ Type::SACHEN_SA0036           , &Board::Make<Sachen::Sa0036> },
+				{ Type::SACHEN_SA0037           , &Board::Make<Sachen::Sa0037> },
+				{ Type::SACHEN_SA0161M          , &Board::Make<Sachen::Sa0161m> },
+				{ Type::SACHEN_SA72007          , &Board::Make<Sachen::Sa72007> },
+				{ Type::SACHEN_SA72008          , &Board::Make<Sachen::Sa72008> },
+				{ Type::SACHEN_74_374A          , &Board::Make<Sachen::S74x374a> },
+				{ Type::SACHEN_74_374B          , &Board::Make<Sachen::S74x374b> },
+				{ Type::SACHEN_STREETHEROES     , &Board::Make<Sachen::StreetHeroes> },
+				#endif
+				#ifndef NST_NO_BOARDS_SOMERITEAM
+				{ Type::SOMERITEAM_SL12         , &Board::Make<SomeriTeam::Sl12> },
+				#endif
+				#ifndef NST_NO_BOARDS_SUBOR
+				{ Type::SUBOR_TYPE0             , &Board::Make<Subor::Type0> },
+				{ Type::SUBOR_TYPE1             , &Board::Make<Subor::Type1> },
+				{ Type::SUBOR_STUDYNGAME        , &Board::Make<Subor::StudyNGame> },
+				#endif
+				#ifndef NST_NO_BOARDS_SUNSOFT
+				{ Type::SUNSOFT_1               , &Board::Make<Sunsoft::S1> },
+				{ Type::SUNSOFT_2A              , &Board::Make<Sunsoft::S2a> },
+				{ Type::SUNSOFT_2B              , &Board::Make<Sunsoft::S2b> },
+				{ Type::SUNSOFT_3               , &Board::Make<Sunsoft::S3> },
+				{ Type::SUNSOFT_4_0             , &Board::Make<Sunsoft::S4> },
+				{ Type::SUNSOFT_4_1             , &Board::Make<Sunsoft::S4> },
+				{ Type::SUNSOFT_5B_0            , &Board::Make<Sunsoft::S5b> },
+				{ Type::SUNSOFT_5B_1            , &Board::Make<Sunsoft::S5b> },
+				{ Type::SUNSOFT_DCS             , &Board::Make<Sunsoft::Dcs> },
+				{ Type::SUNSOFT_FME7_0          , &Board::Make<Sunsoft::Fme7> },
+				{ Type::SUNSOFT_FME7_1          , &Board::Make<Sunsoft::Fme7> },
+				#endif
+				#ifndef NST_NO_BOARDS_SUPERGAME
+				{ Type::SUPERGAME_LIONKING      , &Board::Make<SuperGame::LionKing> },
+				{ Type::SUPERGAME_BOOGERMAN     , &Board::Make<SuperGame::Boogerman> },
+				{ Type::SUPERGAME_MK3E          , &Board::Make<SuperGame::Mk3e> },
+				{ Type::SUPERGAME_POCAHONTAS2   , &Board::Make<SuperGame::Pocahontas2> },
+				#endif
+				#ifndef NST_NO_BOARDS_TAITO
+				{ Type::TAITO_TC0190FMC         , &Board::Make<Taito::Tc0190fmc> },
+				{ Type::TAITO_TC0190FMC_PAL16R4 , &Board::Make<Taito::Tc0190fmcPal16r4> },
+				{ Type::TAITO_X1005             , &Board::Make<Taito::X1005> },
+				{ Type::TAITO_X1017             , &Board::Make<Taito::X1017> },
+				#endif
+				#ifndef NST_NO_BOARDS_TENGEN
+				{ Type::TENGEN_800002           , &Board::Make<Tengen::T800002> },
+				{ Type::TENGEN_800004           , &Board::Make<Tengen::T800004> },
+				{ Type::TENGEN_800008           , &Board::Make<Tengen::T800008> },
+				{ Type::TENGEN_800030           , &Board::Make<Tengen::T800030> },
+				{ Type::TENGEN_800032           , &Board::Make<Tengen::T800032> },
+				{ Type::TENGEN_800037           , &Board::Make<Tengen::T800037> },
+				{ Type::TENGEN_800042           , &Board::Make<Tengen::T800042> },
+				#endif
+				#ifndef NST_NO_BOARDS_TXC
+				{ Type::TXC_22211A              , &Board::Make<Txc::T22211A> },
+				{ Type::TXC_22211B              , &Board::Make<Txc::T22211B> },
+				{ Type::TXC_22211C              , &Board::Make<Txc::T22211C> },
+				{ Type::TXC_MXMDHTWO            , &Board::Make<Txc::Mxmdhtwo> },
+				{ Type::TXC_POLICEMAN           , &Board::Make<Txc::Policeman> },
+				{ Type::TXC_TW                  , &Board::Make<Txc::Tw> },
+				#endif
+				#ifndef NST_NO_BOARDS_UNL
+				{ Type::UNL_A9746               , &Board::Make<Unlicensed::A9746> },
+				{ Type::UNL_CC21                , &Board::Make<Unlicensed::Cc21> },
+				{ Type::UNL_EDU2000             , &Board::Make<Unlicensed::Edu2000> },
+				{ Type::UNL_KINGOFFIGHTERS96    , &Board::Make<Unlicensed::KingOfFighters96> },
+				{ Type::UNL_KINGOFFIGHTERS97    , &Board::Make<Unlicensed::KingOfFighters97> },
+				{ Type::UNL_MORTALKOMBAT2       , &Board::Make<Unlicensed::MortalKombat2> },
+				{ Type::UNL_N625092             , &Board::Make<Unlicensed::N625092> },
+				{ Type::UNL_SUPERFIGHTER3       , &Board::Make<Unlicensed::SuperFighter3> },
+				{ Type::UNL_TF1201              , &Board::Make<Unlicensed::Tf1201> },
+				{ Type::UNL_WORLDHERO           , &Board::Make<Unlicensed::WorldHero> },
+				{ Type::UNL_XZY                 , &Board::Make<Unlicensed::Xzy> },
+				#endif
+				#ifndef NST_NO_BOARDS_WAIXING
+				{ Type::WAIXING_PS2_0           , &Board::Make<Waixing::Ps2> },
+				{ Type::WAIXING_PS2_1           , &Board::Make<Waixing::Ps2> },
+				{ Type::WAIXING_TYPE_A          , &Board::Make<Waixing::TypeA> },
+				{ Type::WAIXING_TYPE_B          , &Board::Make<Waixing::TypeB> },
+				{ Type::WAIXING_TYPE_C          , &Board::Make<Waixing::TypeC> },
+				{ Type::WAIXING_TYPE_D          , &Board::Make<Waixing::TypeD> },
+				{ Type::WAIXING_TYPE_E          , &Board::Make<Waixing::TypeE> },
+				{ Type::WAIXING_TYPE_F          , &Board::Make<Waixing::TypeF> },
+				{ Type::WAIXING_TYPE_G          , &Board::Make<Waixing::TypeG> },
+				{ Type::WAIXING_TYPE_H          , &Board::Make<Waixing::TypeH> },
+				{ Type::WAIXING_TYPE_I          , &Board::Make<Waixing::TypeI> },
+				{ Type::WAIXING_TYPE_J          , &Board::Make<Waixing::TypeJ> },
+				{ Type::WAIXING_FFV_0           , &Board::Make<Waixing::Ffv> },
+				{ Type::WAIXING_FFV_1           , &Board::Make<Waixing::Ffv> },
+				{ Type::WAIXING_SH2_0           , &Board::Make<Waixing::Sh2> },
+				{ Type::WAIXING_SH2_1           , &Board::Make<Waixing::Sh2> },
+				{ Type::WAIXING_ZS              , &Board::Make<Waixing::Zs> },
+				{ Type::WAIXING_DQVII           , &Board::Make<Waixing::Dqv7> },
+				{ Type::WAIXING_SGZ             , &Board::Make<Waixing::Sgz> },
+				{ Type::WAIXING_SGZLZ           , &Board::Make<Waixing::Sgzlz> },
+				{ Type::WAIXING_SECURITY_0      , &Board::Make<Waixing::Security> },
+				{ Type::WAIXING_SECURITY_1      , &Board::Make<Waixing::Security> },
+				#endif
+				#ifndef NST_NO_BOARDS_WHIRLWIND
+				{ Type::WHIRLWIND_2706          , &Board::Make<Whirlwind::W2706> },
+				#endif
+			};
+
+			Board::Registry Board::registry =
+			{
+				entries,
+				sizeof(entries) / sizeof(entries[0]),
+				NULL
+			};
+
+			void Board::Register(Registry& r)
+			{
+				NST_ASSERT( r.entries && r.count && !r.next && &r != &registry );
+
+				r.next = registry.next;
+				registry.next = &r;
+			}
+
 			Board* Board::Create(const Context& c)
 			{
-				switch (c.type.GetId())
+				for (const Registry* r = &registry; r; r = r->next)
 				{
-					case Type::STD_NROM                   :
-					case Type::UNL_NROM                   : return new NRom(c);
-					case Type::STD_AMROM                  :
-					case Type::STD_ANROM                  :
-					case Type::STD_AN1ROM                 :
-					case Type::STD_AOROM                  :
-					case Type::UNL_AXROM                  : return new AxRom(c);
-					case Type::STD_BNROM                  :
-					case Type::UNL_BXROM                  : return new BxRom(c);
-					case Type::STD_CNROM                  :
-					case Type::STD_CXROM                  :
-					case Type::UNL_CXROM                  : return new CnRom(c);
-					case Type::STD_CPROM                  : return new CpRom(c);
-					case Type::STD_DEROM                  :
-					case Type::STD_DE1ROM                 :
-					case Type::STD_DRROM                  : return new DxRom(c);
-					case Type::STD_EKROM                  :
-					case Type::STD_ELROM                  :
-					case Type::STD_ETROM                  :
-					case Type::STD_EWROM                  :
-					case Type::STD_EXROM_0                :
-					case Type::STD_EXROM_1                :
-					case Type::STD_EXROM_2                :
-					case Type::STD_EXROM_3                :
-					case Type::STD_EXROM_4                :
-					case Type::STD_EXROM_5                : return new ExRom(c);
-					case Type::STD_FJROM                  :
-					case Type::STD_FKROM                  : return new FxRom(c);
-					case Type::STD_GNROM                  :
-					case Type::UNL_GXROM                  : return new GxRom(c);
-					case Type::STD_MHROM                  : return new MxRom(c);
-					case Type::STD_HKROM                  : return new HxRom(c);
-					case Type::STD_JLROM                  :
-					case Type::STD_JSROM                  : return new JxRom(c);
-					case Type::STD_NTBROM                 : return new NxRom(c);
-					case Type::STD_PEEOROM                :
-					case Type::STD_PNROM                  :
-					case Type::STD_PNROM_PC10             : return new PxRom(c);
-					case Type::STD_SAROM                  :
-					case Type::STD_SBROM                  :
-					case Type::STD_SCROM                  :
-					case Type::STD_SEROM                  :
-					case Type::STD_SFROM                  :
-					case Type::STD_SGROM                  :
-					case Type::STD_SHROM                  :
-					case Type::STD_SJROM                  :
-					case Type::STD_SKROM                  :
-					case Type::STD_SLROM                  :
-					case Type::STD_SNROM                  :
-					case Type::STD_SOROM                  :
-					case Type::STD_SUROM                  :
-					case Type::STD_SXROM                  : return new SxRom(c);
-					case Type::STD_TBROM                  :
-					case Type::STD_TEROM                  :
-					case Type::STD_TFROM                  :
-					case Type::STD_TGROM                  :
-					case Type::STD_TKROM                  :
-					case Type::STD_TLROM                  :
-					case Type::STD_TNROM                  :
-					case Type::STD_TR1ROM                 :
-					case Type::STD_TSROM                  :
-					case Type::STD_TVROM                  :
-					case Type::UNL_TRXROM                 : return new TxRom  (c);
-					case Type::STD_TLSROM                 : return new TlsRom (c);
-					case Type::STD_TKSROM                 : return new TksRom (c);
-					case Type::STD_TQROM                  : return new TqRom  (c);
-					case Type::STD_UNROM                  :
-					case Type::STD_UN1ROM                 :
-					case Type::STD_UOROM                  :
-					case Type::STD_UXROM                  :
-					case Type::UNL_UXROM                  : return new UxRom(c);
-					case Type::DISCRETE_74_377            : return new Discrete::Ic74x377(c);
-					case Type::DISCRETE_74_139_74         : return new Discrete::Ic74x139x74(c);
-					case Type::DISCRETE_74_161_138        : return new Discrete::Ic74x161x138(c);
-					case Type::DISCRETE_74_161_161_32_A   :
-					case Type::DISCRETE_74_161_161_32_B   : return new Discrete::Ic74x161x161x32(c);
-					case Type::CUSTOM_B4                  : return new TxRom(c);
-					case Type::CUSTOM_BTR                 : return new JxRom(c);
-					case Type::CUSTOM_EVENT               : return new Boards::Event(c);
-					case Type::CUSTOM_FFE3                :
-					case Type::CUSTOM_FFE4                :
-					case Type::CUSTOM_FFE8                : return new Ffe(c);
-					case Type::CUSTOM_FB02                :
-					case Type::CUSTOM_FB04                : return new Fb(c);
-					case Type::CUSTOM_RUMBLESTATION       : return new RumbleStation(c);
-					case Type::CUSTOM_QJ                  : return new Qj(c);
-					case Type::CUSTOM_VSSYSTEM_0          :
-					case Type::CUSTOM_VSSYSTEM_1          : return new VsSystem(c);
-					case Type::CUSTOM_WH                  : return new SxRom(c);
-					case Type::CUSTOM_X79B                : return new CnRom(c);
-					case Type::CUSTOM_ZZ                  : return new Zz(c);
-					case Type::ACCLAIM_MCACC              : return new Acclaim::McAcc(c);
-					case Type::AE_STD                     : return new Ae::Standard(c);
-					case Type::AGCI_50282                 : return new Agci::A50282(c);
-					case Type::AVE_MB_91                  : return new Ave::Mb91(c);
-					case Type::AVE_NINA001                : return new Ave::Nina001(c);
-					case Type::AVE_NINA002                : return new Ave::Nina002(c);
-					case Type::AVE_NINA03                 : return new Ave::Nina03(c);
-					case Type::AVE_NINA06                 : return new Ave::Nina06(c);
-					case Type::AVE_NINA07                 : return new Ave::Nina07(c);
-					case Type::AVE_D1012                  : return new Ave::D1012(c);
-					case Type::BANDAI_FCG1                : return new Bandai::Fcg1(c);
-					case Type::BANDAI_FCG2                : return new Bandai::Fcg2(c);
-					case Type::BANDAI_BAJUMP2             : return new Bandai::Lz93d50(c);
-					case Type::BANDAI_LZ93D50_24C01       :
-					case Type::BANDAI_LZ93D50_24C02       : return new Bandai::Lz93d50Ex(c);
-					case Type::BANDAI_DATACH              : return new Bandai::Datach(c);
-					case Type::BANDAI_KARAOKESTUDIO       : return new Bandai::KaraokeStudio(c);
-					case Type::BANDAI_AEROBICSSTUDIO      : return new Bandai::AerobicsStudio(c);
-					case Type::BANDAI_OEKAKIDS            : return new Bandai::OekaKids(c);
-					case Type::BMC_BALLGAMES_11IN1        : return new Bmc::Ballgames11in1(c);
-					case Type::BMC_A65AS                  : return new Bmc::A65as(c);
-					case Type::BMC_CTC65                  : return new Bmc::Ctc65(c);
-					case Type::BMC_DRAGONBOLLPARTY        : return new Cony::Standard(c);
-					case Type::BMC_110IN1                 : return new Bmc::B110in1(c);
-					case Type::BMC_1200IN1                : return new Bmc::B1200in1(c);
-					case Type::BMC_150IN1                 : return new Bmc::B150in1(c);
-					case Type::BMC_15IN1                  : return new Bmc::B15in1(c);
-					case Type::BMC_20IN1                  : return new Bmc::B20in1(c);
-					case Type::BMC_21IN1                  : return new Bmc::B21in1(c);
-					case Type::BMC_22GAMES                : return new Bmc::B22Games(c);
-					case Type::BMC_31IN1                  : return new Bmc::B31in1(c);
-					case Type::BMC_35IN1                  : return new Bmc::B35in1(c);
-					case Type::BMC_36IN1                  : return new Bmc::B36in1(c);
-					case Type::BMC_64IN1                  : return new Bmc::B64in1(c);
-					case Type::BMC_72IN1                  : return new Bmc::B72in1(c);
-					case Type::BMC_76IN1                  :
-					case Type::BMC_SUPER_42IN1            : return new Bmc::B76in1(c);
-					case Type::BMC_8157                   : return new Bmc::B8157(c);
-					case Type::BMC_9999999IN1             : return new Bmc::B9999999in1(c);
-					case Type::BMC_FAMILY_4646B           : return new Bmc::Family4646B(c);
-					case Type::BMC_FKC23C                 : return new Bmc::Fk23c(c);
-					case Type::BMC_GAME_800IN1            : return new Bmc::Game800in1(c);
-					case Type::BMC_GOLDEN_190IN1          : return new Bmc::Golden190in1(c);
-					case Type::BMC_GOLDENGAME_150IN1      :
-					case Type::BMC_GOLDENGAME_260IN1      : return new Bmc::GoldenGame260in1(c);
-					case Type::BMC_GOLDENCARD_6IN1        : return new Bmc::GoldenCard6in1(c);
-					case Type::BMC_GKA                    : return new Bmc::GamestarA(c);
-					case Type::BMC_GKB                    : return new Bmc::GamestarB(c);
-					case Type::BMC_HERO                   : return new Bmc::Hero(c);
-					case Type::BMC_MARIOPARTY_7IN1        : return new Bmc::MarioParty7in1(c);
-					case Type::BMC_NOVELDIAMOND           : return new Bmc::NovelDiamond(c);
-					case Type::BMC_CH001                  : return new Bmc::Ch001(c);
-					case Type::BMC_POWERJOY_84IN1         : return new Bmc::Powerjoy84in1(c);
-					case Type::BMC_RESETBASED_4IN1        : return new Bmc::ResetBased4in1(c);
-					case Type::BMC_VT5201                 : return new Bmc::Vt5201(c);
-					case Type::BMC_SUPER_24IN1            : return new Bmc::Super24in1(c);
-					case Type::BMC_SUPER_22GAMES          : return new Bmc::Super22Games(c);
-					case Type::BMC_SUPER_40IN1            : return new Bmc::Super40in1(c);
-					case Type::BMC_SUPER_700IN1           : return new Bmc::Super700in1(c);
-					case Type::BMC_SUPERBIG_7IN1          : return new Bmc::SuperBig7in1(c);
-					case Type::BMC_SUPERGUN_20IN1         : return new Bmc::SuperGun20in1(c);
-					case Type::BMC_SUPERHIK_4IN1          : return new Bmc::SuperHiK4in1(c);
-					case Type::BMC_SUPERHIK_300IN1        : return new Bmc::SuperHiK300in1(c);
-					case Type::BMC_SUPERVISION_16IN1      : return new Bmc::SuperVision16in1(c);
-					case Type::BMC_T262                   : return new Bmc::T262(c);
-					case Type::BMC_VRC4                   : return new Bmc::Vrc4(c);
-					case Type::BMC_Y2K_64IN1              : return new Bmc::Y2k64in1(c);
-					case Type::BTL_AISENSHINICOL          :
-					case Type::BTL_MARIOBABY              : return new Btl::MarioBaby(c);
-					case Type::BTL_2708                   : return new Btl::B2708(c);
-					case Type::BTL_AX5705                 : return new Btl::Ax5705(c);
-					case Type::BTL_6035052                : return new Btl::B6035052(c);
-					case Type::BTL_DRAGONNINJA            : return new Btl::DragonNinja(c);
-					case Type::BTL_GENIUSMERIOBROS        : return new Btl::GeniusMerioBros(c);
-					case Type::BTL_SHUIGUANPIPE           : return new Btl::ShuiGuanPipe(c);
-					case Type::BTL_PIKACHUY2K             : return new Btl::PikachuY2k(c);
-					case Type::BTL_SMB2_A                 : return new Btl::Smb2a(c);
-					case Type::BTL_SMB2_B                 : return new Btl::Smb2b(c);
-					case Type::BTL_SMB2_C                 : return new Btl::Smb2c(c);
-					case Type::BTL_SMB3                   : return new Btl::Smb3(c);
-					case Type::BTL_SUPERBROS11            : return new Btl::SuperBros11(c);
-					case Type::BTL_T230                   : return new Btl::T230(c);
-					case Type::BTL_TOBIDASEDAISAKUSEN     : return new Btl::TobidaseDaisakusen(c);
-					case Type::CAMERICA_BF9093            : return new Camerica::Bf9093(c);
-					case Type::CAMERICA_BF9096            : return new Camerica::Bf9096(c);
-					case Type::CAMERICA_BF9097            :
-					case Type::CAMERICA_BF909X            : return new Camerica::Bf9097(c);
-					case Type::CAMERICA_ALGNV11           : return new Camerica::Algnv11(c);
-					case Type::CAMERICA_ALGQV11           : return new Camerica::Algqv11(c);
-					case Type::CAMERICA_GOLDENFIVE        : return new Camerica::GoldenFive(c);
-					case Type::CALTRON_6IN1               : return new Caltron::Mc6in1(c);
-					case Type::CNE_SHLZ                   : return new Cne::Shlz(c);
-					case Type::CNE_DECATHLON              : return new Cne::Decathlon(c);
-					case Type::CNE_PSB                    : return new Cne::Psb(c);
-					case Type::CONY_STD                   : return new Cony::Standard(c);
-					case Type::DREAMTECH_01               : return new DreamTech::D01(c);
-					case Type::FUTUREMEDIA_STD            : return new FutureMedia::Standard(c);
-					case Type::FUJIYA_STD                 : return new Fujiya::Standard(c);
-					case Type::FUKUTAKE_SBX               : return new Fukutake::Sbx(c);
-					case Type::GOUDER_37017               : return new Gouder::G37017(c);
-					case Type::HES_STD                    : return new Hes::Standard(c);
-					case Type::BENSHENG_BS5               : return new Bensheng::Bs5(c);
-					case Type::HENGEDIANZI_STD            : return new Hengedianzi::Standard(c);
-					case Type::HENGEDIANZI_XJZB           : return new Hengedianzi::Xjzb(c);
-					case Type::HOSENKAN_STD               : return new Hosenkan::Standard(c);
-					case Type::IREM_G101A_0               :
-					case Type::IREM_G101A_1               :
-					case Type::IREM_G101B_0               :
-					case Type::IREM_G101B_1               : return new Irem::G101(c);
-					case Type::IREM_H3001                 : return new Irem::H3001(c);
-					case Type::IREM_LROG017               : return new Irem::Lrog017(c);
-					case Type::IREM_HOLYDIVER             : return new Irem::HolyDiver(c);
-					case Type::IREM_KAIKETSU              : return new Irem::Kaiketsu(c);
-					case Type::JALECO_JF01                : return new Jaleco::Jf01(c);
-					case Type::JALECO_JF02                : return new Jaleco::Jf02(c);
-					case Type::JALECO_JF03                : return new Jaleco::Jf03(c);
-					case Type::JALECO_JF04                : return new Jaleco::Jf04(c);
-					case Type::JALECO_JF05                : return new Jaleco::Jf05(c);
-					case Type::JALECO_JF06                : return new Jaleco::Jf06(c);
-					case Type::JALECO_JF07                : return new Jaleco::Jf07(c);
-					case Type::JALECO_JF08                : return new Jaleco::Jf08(c);
-					case Type::JALECO_JF09                : return new Jaleco::Jf09(c);
-					case Type::JALECO_JF10                : return new Jaleco::Jf10(c);
-					case Type::JALECO_JF11                : return new Jaleco::Jf11(c);
-					case Type::JALECO_JF12                : return new Jaleco::Jf12(c);
-					case Type::JALECO_JF13                : return new Jaleco::Jf13(c);
-					case Type::JALECO_JF14                : return new Jaleco::Jf14(c);
-					case Type::JALECO_JF15                : return new Jaleco::Jf15(c);
-					case Type::JALECO_JF16                : return new Jaleco::Jf16(c);
-					case Type::JALECO_JF17                : return new Jaleco::Jf17(c);
-					case Type::JALECO_JF18                : return new Jaleco::Jf18(c);
-					case Type::JALECO_JF19                : return new Jaleco::Jf19(c);
-					case Type::JALECO_JF20                : return new Jaleco::Jf20(c);
-					case Type::JALECO_JF21                : return new Jaleco::Jf21(c);
-					case Type::JALECO_JF22                : return new Jaleco::Jf22(c);
-					case Type::JALECO_JF23                : return new Jaleco::Jf23(c);
-					case Type::JALECO_JF24                : return new Jaleco::Jf24(c);
-					case Type::JALECO_JF25                : return new Jaleco::Jf25(c);
-					case Type::JALECO_JF26                : return new Jaleco::Jf26(c);
-					case Type::JALECO_JF27                : return new Jaleco::Jf27(c);
-					case Type::JALECO_JF28                : return new Jaleco::Jf28(c);
-					case Type::JALECO_JF29                : return new Jaleco::Jf29(c);
-					case Type::JALECO_JF30                : return new Jaleco::Jf30(c);
-					case Type::JALECO_JF31                : return new Jaleco::Jf31(c);
-					case Type::JALECO_JF32                : return new Jaleco::Jf32(c);
-					case Type::JALECO_JF33                : return new Jaleco::Jf33(c);
-					case Type::JALECO_JF34                : return new Jaleco::Jf34(c);
-					case Type::JALECO_JF35                : return new Jaleco::Jf35(c);
-					case Type::JALECO_JF36                : return new Jaleco::Jf36(c);
-					case Type::JALECO_JF37                : return new Jaleco::Jf37(c);
-					case Type::JALECO_JF38                : return new Jaleco::Jf38(c);
-					case Type::JALECO_JF39                : return new Jaleco::Jf39(c);
-					case Type::JALECO_JF40                : return new Jaleco::Jf40(c);
-					case Type::JALECO_JF41                : return new Jaleco::Jf41(c);
-					case Type::JALECO_SS88006             : return new Jaleco::Ss88006(c);
-					case Type::JYCOMPANY_TYPE_A           :
-					case Type::JYCOMPANY_TYPE_B           :
-					case Type::JYCOMPANY_TYPE_C           : return new JyCompany::Standard(c);
-					case Type::KAISER_KS202               : return new Kaiser::Ks202(c);
-					case Type::KAISER_KS7022              : return new Kaiser::Ks7022(c);
-					case Type::KAISER_KS7032              : return new Kaiser::Ks7032(c);
-					case Type::KAISER_KS7058              : return new Kaiser::Ks7058(c);
-					case Type::KASING_STD                 : return new Kasing::Standard(c);
-					case Type::KAY_H2288                  : return new Kay::H2288(c);
-					case Type::KAY_PANDAPRINCE            : return new Kay::PandaPrince(c);
-					case Type::KONAMI_VRC1                : return new Konami::Vrc1(c);
-					case Type::KONAMI_VRC2                : return new Konami::Vrc2(c);
-					case Type::KONAMI_VRC3                : return new Konami::Vrc3(c);
-					case Type::KONAMI_VRC4_0              :
-					case Type::KONAMI_VRC4_1              :
-					case Type::KONAMI_VRC4_2              : return new Konami::Vrc4(c);
-					case Type::KONAMI_VRC6_0              :
-					case Type::KONAMI_VRC6_1              : return new Konami::Vrc6(c);
-					case Type::KONAMI_VRC7_0              :
-					case Type::KONAMI_VRC7_1              : return new Konami::Vrc7(c);
-					case Type::KONAMI_VSSYSTEM            : return new Konami::VsSystem(c);
-					case Type::MAGICSERIES_MAGICDRAGON    : return new MagicSeries::MagicDragon(c);
-					case Type::NAMCOT_3425                : return new Namcot::N3425(c);
-					case Type::NAMCOT_3433                : return new Namcot::N3433(c);
-					case Type::NAMCOT_3443                : return new Namcot::N3443(c);
-					case Type::NAMCOT_3446                : return new Namcot::N3446(c);
-					case Type::NAMCOT_34XX                : return new Namcot::N34xx(c);
-					case Type::NAMCOT_163_0               :
-					case Type::NAMCOT_163_1               :
-					case Type::NAMCOT_163_S_0             :
-					case Type::NAMCOT_163_S_1             : return new Namcot::N163(c);
-					case Type::NAMCOT_340                 :
-					case Type::NAMCOT_175                 : return new Namcot::N175(c);
-					case Type::NANJING_STD                : return new Nanjing::Standard(c);
-					case Type::UNL_UXROM_M5               :
-					case Type::NIHON_UNROM_M5             : return new Nihon::UnRomM5(c);
-					case Type::NITRA_TDA                  : return new Nitra::Tda(c);
-					case Type::NTDEC_N715062              : return new Ntdec::N715062(c);
-					case Type::NTDEC_ASDER_0              :
-					case Type::NTDEC_ASDER_1              : return new Ntdec::Asder(c);
-					case Type::NTDEC_FIGHTINGHERO         : return new Ntdec::FightingHero(c);
-					case Type::OPENCORP_DAOU306           : return new OpenCorp::Daou306(c);
-					case Type::REXSOFT_SL1632             : return new RexSoft::Sl1632(c);
-					case Type::REXSOFT_DBZ5               : return new RexSoft::Dbz5(c);
-					case Type::RCM_GS2013                 : return new Rcm::Gs2013(c);
-					case Type::RCM_GS2015                 : return new Rcm::Gs2015(c);
-					case Type::RCM_GS2004                 : return new Rcm::Gs2004(c);
-					case Type::RCM_TETRISFAMILY           : return new Rcm::TetrisFamily(c);
-					case Type::SACHEN_8259A               :
-					case Type::SACHEN_8259B               :
-					case Type::SACHEN_8259C               :
-					case Type::SACHEN_8259D               : return new Sachen::S8259(c);
-					case Type::SACHEN_TCA01               : return new Sachen::Tca01(c);
-					case Type::SACHEN_TCU01               : return new Sachen::Tcu01(c);
-					case Type::SACHEN_TCU02               : return new Sachen::Tcu02(c);
-					case Type::SACHEN_SA0036              : return new Sachen::Sa0036(c);
-					case Type::SACHEN_SA0037              : return new Sachen::Sa0037(c);
-					case Type::SACHEN_SA0161M             : return new Sachen::Sa0161m(c);
-					case Type::SACHEN_SA72007             : return new Sachen::Sa72007(c);
-					case Type::SACHEN_SA72008             : return new Sachen::Sa72008(c);
-					case Type::SACHEN_74_374A             : return new Sachen::S74x374a(c);
-					case Type::SACHEN_74_374B             : return new Sachen::S74x374b(c);
-					case Type::SACHEN_STREETHEROES        : return new Sachen::StreetHeroes(c);
-					case Type::SOMERITEAM_SL12            : return new SomeriTeam::Sl12(c);
-					case Type::SUBOR_TYPE0                : return new Subor::Type0(c);
-					case Type::SUBOR_TYPE1                : return new Subor::Type1(c);
-					case Type::SUBOR_STUDYNGAME           : return new Subor::StudyNGame(c);
-					case Type::SUNSOFT_1                  : return new Sunsoft::S1(c);
-					case Type::SUNSOFT_2A                 : return new Sunsoft::S2a(c);
-					case Type::SUNSOFT_2B                 : return new Sunsoft::S2b(c);
-					case Type::SUNSOFT_3                  : return new Sunsoft::S3(c);
-					case Type::SUNSOFT_4_0                :
-					case Type::SUNSOFT_4_1                : return new Sunsoft::S4(c);
-					case Type::SUNSOFT_5B_0               :
-					case Type::SUNSOFT_5B_1               : return new Sunsoft::S5b(c);
-					case Type::SUNSOFT_DCS                : return new Sunsoft::Dcs(c);
-					case Type::SUNSOFT_FME7_0             :
-					case Type::SUNSOFT_FME7_1             : return new Sunsoft::Fme7(c);
-					case Type::SUPERGAME_LIONKING         : return new SuperGame::LionKing(c);
-					case Type::SUPERGAME_BOOGERMAN        : return new SuperGame::Boogerman(c);
-					case Type::SUPERGAME_MK3E             : return new SuperGame::Mk3e(c);
-					case Type::SUPERGAME_POCAHONTAS2      : return new SuperGame::Pocahontas2(c);
-					case Type::TAITO_TC0190FMC            : return new Taito::Tc0190fmc(c);
-					case Type::TAITO_TC0190FMC_PAL16R4    : return new Taito::Tc0190fmcPal16r4(c);
-					case Type::TAITO_X1005                : return new Taito::X1005(c);
-					case Type::TAITO_X1017                : return new Taito::X1017(c);
-					case Type::TENGEN_800002              : return new Tengen::T800002(c);
-					case Type::TENGEN_800004              : return new Tengen::T800004(c);
-					case Type::TENGEN_800008              : return new Tengen::T800008(c);
-					case Type::TENGEN_800030              : return new Tengen::T800030(c);
-					case Type::TENGEN_800032              : return new Tengen::T800032(c);
-					case Type::TENGEN_800037              : return new Tengen::T800037(c);
-					case Type::TENGEN_800042              : return new Tengen::T800042(c);
-					case Type::TXC_22211A                 : return new Txc::T22211A(c);
-					case Type::TXC_22211B                 : return new Txc::T22211B(c);
-					case Type::TXC_22211C                 : return new Txc::T22211C(c);
-					case Type::TXC_MXMDHTWO               : return new Txc::Mxmdhtwo(c);
-					case Type::TXC_POLICEMAN              : return new Txc::Policeman(c);
-					case Type::TXC_TW                     : return new Txc::Tw(c);
-					case Type::UNL_A9746                  : return new Unlicensed::A9746(c);
-					case Type::UNL_CC21                   : return new Unlicensed::Cc21(c);
-					case Type::UNL_EDU2000                : return new Unlicensed::Edu2000(c);
-					case Type::UNL_KINGOFFIGHTERS96       : return new Unlicensed::KingOfFighters96(c);
-					case Type::UNL_KINGOFFIGHTERS97       : return new Unlicensed::KingOfFighters97(c);
-					case Type::UNL_MORTALKOMBAT2          : return new Unlicensed::MortalKombat2(c);
-					case Type::UNL_N625092                : return new Unlicensed::N625092(c);
-					case Type::UNL_SUPERFIGHTER3          : return new Unlicensed::SuperFighter3(c);
-					case Type::UNL_TF1201                 : return new Unlicensed::Tf1201(c);
-					case Type::UNL_WORLDHERO              : return new Unlicensed::WorldHero(c);
-					case Type::UNL_XZY                    : return new Unlicensed::Xzy(c);
-					case Type::WAIXING_PS2_0              :
-					case Type::WAIXING_PS2_1              : return new Waixing::Ps2(c);
-					case Type::WAIXING_TYPE_A             : return new Waixing::TypeA(c);
-					case Type::WAIXING_TYPE_B             : return new Waixing::TypeB(c);
-					case Type::WAIXING_TYPE_C             : return new Waixing::TypeC(c);
-					case Type::WAIXING_TYPE_D             : return new Waixing::TypeD(c);
-					case Type::WAIXING_TYPE_E             : return new Waixing::TypeE(c);
-					case Type::WAIXING_TYPE_F             : return new Waixing::TypeF(c);
-					case Type::WAIXING_TYPE_G             : return new Waixing::TypeG(c);
-					case Type::WAIXING_TYPE_H             : return new Waixing::TypeH(c);
-					case Type::WAIXING_TYPE_I             : return new Waixing::TypeI(c);
-					case Type::WAIXING_TYPE_J             : return new Waixing::TypeJ(c);
-					case Type::WAIXING_FFV_0              :
-					case Type::WAIXING_FFV_1              : return new Waixing::Ffv(c);
-					case Type::WAIXING_SH2_0              :
-					case Type::WAIXING_SH2_1              : return new Waixing::Sh2(c);
-					case Type::WAIXING_ZS                 : return new Waixing::Zs(c);
-					case Type::WAIXING_DQVII              : return new Waixing::Dqv7(c);
-					case Type::WAIXING_SGZ                : return new Waixing::Sgz(c);
-					case Type::WAIXING_SGZLZ              : return new Waixing::Sgzlz(c);
-					case Type::WAIXING_SECURITY_0         :
-					case Type::WAIXING_SECURITY_1         : return new Waixing::Security(c);
-					case Type::WHIRLWIND_2706             : return new Whirlwind::W2706(c);
-					case Type::UNKNOWN                    : default: break;
+					for (const Entry *it = r->entries, *const end = r->entries + r->count; it != end; ++it)
+					{
+						if (it->id == c.type.GetId())
+							return it->create( c );
+					}
 				}
 
 				return NULL;
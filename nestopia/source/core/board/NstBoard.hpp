@@ -663,6 +663,42 @@ namespace Nes
 				static Board* Create(const Context&);
 				static void Destroy(Board*);
 
+				template<typename T>
+				static Board* Make(const Context& c)
+				{
+					return new T(c);
+				}
+
+				template<typename T>
+				static Board* MakeDirect(const Context& c)
+				{
+					Board* const board = new T(c);
+					board->directPrg = true;
+					return board;
+				}
+
+				struct Entry
+				{
+					Type::Id id;
+					Board* (*create)(const Context&);
+				};
+
+				struct Registry
+				{
+					const Entry* entries;
+					uint count;
+					Registry* next;
+				};
+
+				static void Register(Registry&);
+
+			private:
+
+				static const Entry entries[];
+				static Registry registry;
+
+			public:
+
 				void Reset(bool);
 
 				virtual void Load(File&);
@@ -715,6 +751,8 @@ namespace Nes
 
 			private:
 
+				bool directPrg;
+
 				virtual void SubReset(bool) = 0;
 				virtual void SubSave(State::Saver&) const {}
 				virtual void SubLoad(State::Loader&,dword) {}
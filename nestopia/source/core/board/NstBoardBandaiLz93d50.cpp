@@ -212,6 +212,16 @@ namespace Nes
 					return (count-- & 0xFFFF) == 0;
 				}
 
+				dword Lz93d50::Irq::Remaining() const
+				{
+					return (count & 0xFFFF) + 1;
+				}
+
+				void Lz93d50::Irq::Advance(const dword clocks)
+				{
+					count -= clocks;
+				}
+
 				void Lz93d50::Sync(Event event,Input::Controllers* controllers)
 				{
 					if (event == EVENT_END_FRAME)
@@ -62,13 +62,15 @@ namespace Nes
 					{
 						void Reset(bool);
 						bool Clock();
+						dword Remaining() const;
+						void Advance(dword);
 
 						uint count;
 						uint latch;
 					};
 
 					byte regs[8];
-					Timer::M2<Irq> irq;
+					Timer::LazyM2<Irq> irq;
 				};
 			}
 		}
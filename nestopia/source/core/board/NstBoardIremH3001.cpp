@@ -156,6 +156,17 @@ namespace Nes
 					return false;
 				}
 
+				dword H3001::Irq::Remaining() const
+				{
+					return enabled ? count : 0;
+				}
+
+				void H3001::Irq::Advance(const dword clocks)
+				{
+					if (enabled && count)
+						count -= clocks;
+				}
+
 				void H3001::Sync(Event event,Input::Controllers* controllers)
 				{
 					if (event == EVENT_END_FRAME)
@@ -60,13 +60,15 @@ namespace Nes
 					{
 						void Reset(bool);
 						bool Clock();
+						dword Remaining() const;
+						void Advance(dword);
 
 						ibool enabled;
 						uint count;
 						uint latch;
 					};
 
-					Timer::M2<Irq> irq;
+					Timer::LazyM2<Irq> irq;
 				};
 			}
 		}
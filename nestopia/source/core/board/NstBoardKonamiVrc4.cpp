@@ -306,6 +306,29 @@ namespace Nes
 					return true;
 				}
 
+				dword Vrc4::BaseIrq::Remaining() const
+				{
+					const dword steps = 0x100 - count[1];
+
+					if (ctrl & NO_PPU_SYNC)
+						return steps;
+
+					// the prescaler gains 3 per clock and steps the counter every 341
+					return (steps * 341 - count[0] + 2) / 3;
+				}
+
+				void Vrc4::BaseIrq::Advance(dword clocks)
+				{
+					if (!(ctrl & NO_PPU_SYNC))
+					{
+						clocks = count[0] + clocks * 3;
+						count[0] = clocks % 341;
+						clocks /= 341;
+					}
+
+					count[1] += clocks;
+				}
+
 				void Vrc4::Sync(Event event,Input::Controllers* controllers)
 				{
 					if (event == EVENT_END_FRAME)
@@ -53,6 +53,8 @@ namespace Nes
 					{
 						void Reset(bool);
 						bool Clock();
+						dword Remaining() const;
+						void Advance(dword);
 
 						enum
 						{
@@ -69,7 +71,7 @@ namespace Nes
 
 				public:
 
-					struct Irq : Timer::M2<BaseIrq>
+					struct Irq : Timer::LazyM2<BaseIrq>
 					{
 						void WriteLatch0(uint);
 						void WriteLatch1(uint);
@@ -79,7 +81,7 @@ namespace Nes
 						void SaveState(State::Saver&,dword) const;
 
 						explicit Irq(Cpu& c)
-						: Timer::M2<BaseIrq>(c) {}
+						: Timer::LazyM2<BaseIrq>(c) {}
 					};
 
 				private:
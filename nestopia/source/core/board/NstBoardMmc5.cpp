@@ -134,6 +134,27 @@ namespace Nes
 				chrBank = 0;
 				x = 0;
 				y = 0;
+
+				Update();
+			}
+
+			void Mmc5::Spliter::Update()
+			{
+				const uint start = ctrl & CTRL_START;
+
+				if (ctrl & CTRL_RIGHT_SIDE)
+					columns = 0xFFFFFFFF << start;
+				else
+					columns = (dword(1) << start) - 1;
+
+				UpdateRow();
+			}
+
+			inline void Mmc5::Spliter::UpdateRow()
+			{
+				row = (y & 0xF8) << 2;
+				attributes = 0x3C0 | (y >> 2 & 0x38);
+				shift = y >> 2 & 0x4;
 			}
 
 			void Mmc5::ExRam::Reset(bool hard)
@@ -673,6 +694,8 @@ namespace Nes
 						spliter.y = spliter.yStart;
 					}
 
+					spliter.UpdateRow();
+
 					if (banks.lastChr != Banks::LAST_CHR_A || IsPpuSprite8x16())
 						UpdateChrB();
 					else
@@ -824,7 +847,7 @@ namespace Nes
 				}
 			}
 
-			bool Mmc5::ClockSpliter()
+			NST_FORCE_INLINE bool Mmc5::ClockSpliter()
 			{
 				NST_ASSERT( spliter.ctrl & Spliter::CTRL_ENABLED );
 
@@ -832,13 +855,9 @@ namespace Nes
 				{
 					spliter.x = (spliter.x + 1) & 0x1F;
 
-					if
-					(
-						(spliter.ctrl & Spliter::CTRL_RIGHT_SIDE) ? (spliter.x >= (spliter.ctrl & Spliter::CTRL_START)) :
-																	(spliter.x <  (spliter.ctrl & Spliter::CTRL_START))
-					)
+					if (spliter.columns >> spliter.x & 0x1)
 					{
-						spliter.tile = ((spliter.y & 0xF8) << 2) | spliter.x;
+						spliter.tile = spliter.row | spliter.x;
 						spliter.inside = true;
 						return true;
 					}
@@ -944,7 +963,7 @@ namespace Nes
 
 			uint Mmc5::GetSpliterAttribute() const
 			{
-				return Filler::squared[(exRam.mem[0x3C0 | (spliter.tile >> 4 & 0x38) | (spliter.tile >> 2 & 0x7)] >> ((spliter.tile >> 4 & 0x4) | (spliter.tile & 0x2))) & 0x3];
+				return Filler::squared[(exRam.mem[spliter.attributes | (spliter.tile >> 2 & 0x7)] >> (spliter.shift | (spliter.tile & 0x2))) & 0x3];
 			}
 
 			NES_ACCESSOR( Mmc5, Nt_CiRam_0         ) { return FetchNt         < NT_CIRAM_0 >( address ); }
@@ -1018,6 +1037,8 @@ namespace Nes
 
 				const uint method = regs.exRamMode | (spliter.ctrl >> 5 & 0x4);
 
+				spliter.Update();
+
 				{
 					static const Io::Accessor::Type<Mmc5>::Function chrMethods[8] =
 					{
@@ -189,7 +189,7 @@ namespace Nes
 				void UpdateChrB() const;
 				void UpdateRenderMethod();
 
-				bool ClockSpliter();
+				NST_FORCE_INLINE bool ClockSpliter();
 
 				inline void Update();
 				inline ibool IsPpuSprite8x16() const;
@@ -433,6 +433,8 @@ namespace Nes
 				struct Spliter
 				{
 					void Reset();
+					void Update();
+					inline void UpdateRow();
 
 					enum
 					{
@@ -448,6 +450,10 @@ namespace Nes
 					uint chrBank;
 					uint x;
 					uint y;
+					dword columns;
+					uint row;
+					uint attributes;
+					uint shift;
 				};
 
 				struct ExRam
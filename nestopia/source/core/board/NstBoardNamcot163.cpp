@@ -272,6 +272,17 @@ namespace Nes
 					return (count - 0x8000 < 0x7FFF) && (++count == 0xFFFF);
 				}
 
+				dword N163::Irq::Remaining() const
+				{
+					return (count - 0x8000 < 0x7FFF) ? 0xFFFF - count : 0;
+				}
+
+				void N163::Irq::Advance(const dword clocks)
+				{
+					if (count - 0x8000 < 0x7FFF)
+						count += clocks;
+				}
+
 				inline bool N163::Sound::BaseChannel::CanOutput() const
 				{
 					return volume && frequency && enabled;
@@ -155,6 +155,8 @@ namespace Nes
 					{
 						void Reset(bool);
 						bool Clock();
+						dword Remaining() const;
+						void Advance(dword);
 
 						uint count;
 					};
@@ -171,7 +173,7 @@ namespace Nes
 					NES_DECL_POKE( D800 );
 					NES_DECL_POKE( F800 );
 
-					Timer::M2<Irq> irq;
+					Timer::LazyM2<Irq> irq;
 					Sound sound;
 				};
 			}
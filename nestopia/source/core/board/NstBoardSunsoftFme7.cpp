@@ -196,6 +196,16 @@ namespace Nes
 					return count < enabled;
 				}
 
+				dword Fme7::Irq::Remaining() const
+				{
+					return enabled ? (count ? count : 0x10000) : 0;
+				}
+
+				void Fme7::Irq::Advance(const dword clocks)
+				{
+					count = (count - clocks) & 0xFFFF;
+				}
+
 				void Fme7::Sync(Event event,Input::Controllers* controllers)
 				{
 					if (event == EVENT_END_FRAME)
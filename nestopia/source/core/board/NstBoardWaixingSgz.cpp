@@ -39,7 +39,18 @@ namespace Nes
 				#endif
 
 				Sgz::Sgz(const Context& c)
-				: Board(c), irq(*c.cpu) {}
+				: Board(c), irq(*c.cpu)
+				{
+					// CHR-ROM gets written to, take a private copy if it's shared
+					if (c.chr.Size() && !c.chr.Internal())
+					{
+						c.chr.Unshare();
+						chr.Source(0).Set( c.chr );
+
+						if (!board.GetNmtRam())
+							nmt.Source(1).Set( chr.Source().Reference() );
+					}
+				}
 
 				void Sgz::SubReset(const bool hard)
 				{
@@ -58,6 +58,7 @@ namespace Nes
 				strobe = 0;
 				stream = 0xFF;
 				state = 0;
+				timed = false;
 				mic = 0;
 			}
 
@@ -89,20 +90,42 @@ namespace Nes
 			void Pad::BeginFrame(Controllers* i)
 			{
 				input = i;
+				timed = false;
 				mic = 0;
 			}
 
+			bool Pad::IsDue(const ulong time) const
+			{
+				const ulong span = input->timing.end - input->timing.begin;
+				const ulong offset = time - input->timing.begin;
+
+				if (!span || offset > span)
+					return true;
+
+				return qaword(offset) * cpu.GetFrameCycles() <= qaword(cpu.GetCycles()) * span;
+			}
+
 			void Pad::Poll()
 			{
 				if (input)
 				{
 					Controllers::Pad& pad = input->pad[type - Api::Input::PAD1];
-					input = NULL;
 
-					if (Controllers::Pad::callback( pad, type - Api::Input::PAD1 ))
+					if (timed || Controllers::Pad::callback( pad, type - Api::Input::PAD1 ))
 					{
 						uint buttons = pad.buttons;
 
+						// with timed events pending the pad is
+						// polled again until the last one is due
+
+						const uint count = NST_MIN(pad.numEvents,uint(Controllers::Pad::MAX_EVENTS));
+						uint i = 0;
+
+						for (; i < count && IsDue( pad.events[i].time ); ++i)
+							buttons = pad.events[i].buttons;
+
+						timed = (i < count);
+
 						enum
 						{
 							UP    = Controllers::Pad::UP,
@@ -124,6 +147,9 @@ namespace Nes
 					}
 
 					mic |= pad.mic;
+
+					if (!timed)
+						input = NULL;
 				}
 			}
 
@@ -46,6 +46,7 @@ namespace Nes
 				void BeginFrame(Controllers*);
 				void Reset();
 				void Poll();
+				bool IsDue(ulong) const;
 				void Poke(uint);
 				uint Peek(uint);
 				void LoadState(State::Loader&,dword);
@@ -54,6 +55,7 @@ namespace Nes
 				uint strobe;
 				uint stream;
 				uint state;
+				ibool timed;
 
 				static uint mic;
 			};
@@ -44,6 +44,9 @@ static SDL_AudioDeviceID dev;
 
 static int16_t audiobuf[6400];
 
+// Filled by the emulation thread, drained by the device
+static Sound::Ring audioring;
+
 static int framerate, channels, bufsize;
 
 static bool altspeed = false;
@@ -60,6 +63,7 @@ void audio_output_sdl() {
 
 void audio_output_ao() {
 #ifndef _MINGW
+	audioring.Read(audiobuf, bufsize / (2 * channels));
 	ao_play(aodevice, (char*)audiobuf, bufsize);
 #endif
 }
@@ -83,11 +87,15 @@ void audio_play() {
 }
 
 void audio_cb_sdl(void *data, uint8_t *stream, int len) {
-	uint8_t *soundbuf = (uint8_t*)audiobuf;
-	
-	for (int i = 0; i < len; i++) {
-		stream[i] = soundbuf[i];
-	}
+	audioring.Read(stream, len / (2 * channels));
+}
+
+bool audio_lock(Sound::Output& soundoutput) {
+	return audioring.Lock(soundoutput, conf.audio_sample_rate / framerate);
+}
+
+void audio_unlock(Sound::Output& soundoutput) {
+	audioring.Unlock(soundoutput);
 }
 
 void audio_init_sdl() {
@@ -142,6 +150,9 @@ void audio_init() {
 	channels = conf.audio_stereo ? 2 : 1;
 	memset(audiobuf, 0, sizeof(audiobuf));
 	
+	// Room for a few frames, enough to ride out scheduling hiccups
+	audioring.SetFormat((conf.audio_sample_rate / framerate) * 4, 16, channels);
+	
 	#ifdef _MINGW
 	conf.audio_api = 0; // Set SDL audio for MinGW
 	#endif
@@ -218,11 +229,11 @@ void audio_adj_volume() {
 bool timing_frameskip() {
 	// Calculate whether to skip a frame or not
 	
-	if (conf.audio_api == 0) { // SDL
+	if (conf.audio_api == 0 && conf.timing_limiter && !paused) { // SDL
 		// Wait until the audio is drained
-		//while (SDL_GetQueuedAudioSize(dev) > (Uint32)bufsize) {
-		//	if (conf.timing_limiter) { SDL_Delay(1); }
-		//}
+		while (audioring.GetFilled() > (Uint32)(conf.audio_sample_rate / framerate) * 2) {
+			SDL_Delay(1);
+		}
 	}
 	
 	static int fskip;
@@ -234,7 +245,11 @@ void timing_set_default() {
 	// Set the framerate to the default
 	altspeed = false;
 	framerate = nst_pal ? (conf.timing_speed / 6) * 5 : conf.timing_speed;
-	//if (conf.audio_api == 0) { SDL_ClearQueuedAudio(dev); }
+	if (conf.audio_api == 0) {
+		SDL_LockAudioDevice(dev);
+		audioring.Clear();
+		SDL_UnlockAudioDevice(dev);
+	}
 }
 
 void timing_set_altspeed() {
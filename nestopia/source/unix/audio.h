@@ -14,6 +14,8 @@ void audio_play();
 void audio_pause();
 void audio_unpause();
 void audio_set_params(Sound::Output *soundoutput);
+bool audio_lock(Sound::Output& soundoutput);
+void audio_unlock(Sound::Output& soundoutput);
 void audio_adj_volume();
 
 bool timing_frameskip();
@@ -27,6 +27,8 @@
 #include "main.h"
 #include "cli.h"
 #include "config.h"
+#include "nsfrender.h"
+#include "scanner.h"
 
 extern settings_t conf;
 
@@ -55,6 +57,17 @@ void cli_show_usage() {
 	printf("  -u, --unlimitedsprites  Remove sprite limit\n");
 	printf("  -q, --spritelimit       Enable sprite limit\n\n");
 	printf("  -v, --version           Show version information\n\n");
+	printf("  --nsfrender DIR         Render NSF tracks to WAV files in DIR and exit\n");
+	printf("                          (Usage: nestopia --nsfrender DIR [options] FILE...)\n");
+	printf("  --tracks LIST           Tracks to render, such as 1,3-5 (default: all)\n");
+	printf("  --length SECS           Maximum track length (default: 180)\n");
+	printf("  --silence SECS          End a track after this much silence, 0 to disable (default: 3)\n");
+	printf("  --jobs N                Number of tracks rendered or files scanned at once\n");
+	printf("                          (default: one per CPU)\n\n");
+	printf("  --convertdb OUT         Convert an XML database to the binary format and exit\n");
+	printf("                          (Usage: nestopia --convertdb NstDatabase.bin NstDatabase.xml)\n\n");
+	printf("  --scan INDEX            Scan directories for games and write a library index\n");
+	printf("                          (Usage: nestopia --scan INDEX [--jobs N] DIR...)\n\n");
 	printf("More options can be set in the configuration file.\n");
 	printf("Options are saved, and do not need to be set on future invocations.\n\n");
 }
@@ -66,6 +79,12 @@ void cli_show_version() {
 void cli_handle_command(int argc, char *argv[]) {
 	int c;
 	int optint;
+	
+	nsfrender_t rendersettings;
+	nsfrender_set_default(&rendersettings);
+	
+	const char *dbout = NULL;
+	const char *scanindex = NULL;
 
 	while (1) {
 		static struct option long_options[] = {
@@ -85,6 +104,13 @@ void cli_handle_command(int argc, char *argv[]) {
 			{"unlimitedsprites", no_argument, 0, 'u'},
 			{"spritelimit", no_argument, 0, 'q'},
 			{"version", no_argument, 0, 'v'},
+			{"nsfrender", required_argument, 0, 'N'},
+			{"tracks", required_argument, 0, 'T'},
+			{"length", required_argument, 0, 'L'},
+			{"silence", required_argument, 0, 'S'},
+			{"jobs", required_argument, 0, 'J'},
+			{"convertdb", required_argument, 0, 'C'},
+			{"scan", required_argument, 0, 'I'},
 			{0, 0, 0, 0}
 		};
 		
@@ -174,9 +200,60 @@ void cli_handle_command(int argc, char *argv[]) {
 				exit(0);
 				break;
 			
+			// Long options only, not in the short option string
+			case 'N':
+				rendersettings.outdir = optarg;
+				break;
+			
+			case 'T':
+				rendersettings.tracks = optarg;
+				break;
+			
+			case 'L':
+				rendersettings.length = atoi(optarg);
+				break;
+			
+			case 'S':
+				optint = atoi(optarg);
+				if (optint >= 0) {
+					rendersettings.silence = optint;
+				}
+				else {
+					cli_error("Error: Invalid silence length");
+				}
+				break;
+			
+			case 'J':
+				rendersettings.jobs = atoi(optarg);
+				break;
+			
+			case 'C':
+				dbout = optarg;
+				break;
+			
+			case 'I':
+				scanindex = optarg;
+				break;
+			
 			default:
 				cli_error("Error: Invalid option");
 				break;
 		}
 	}
+	
+	// Convert the database and exit
+	if (dbout) {
+		if (argc - optind != 1) { cli_error("Error: No XML database given"); }
+		exit(nst_convert_db(argv[optind], dbout) ? 0 : 1);
+	}
+	
+	// Scan a game library and exit
+	if (scanindex) {
+		exit(scanner_run(scanindex, rendersettings.jobs, argc - optind, argv + optind));
+	}
+	
+	// Render NSF files headlessly and exit without touching the GUI
+	if (rendersettings.outdir) {
+		exit(nsfrender_run(&rendersettings, argc - optind, argv + optind));
+	}
 }
@@ -120,11 +120,11 @@ static void NST_CALLBACK VideoUnlock(void* userData, Video::Output& video) {
 }
 
 static bool NST_CALLBACK SoundLock(void* userData, Sound::Output& sound) {
-	return true;
+	return audio_lock(sound);
 }
 
 static void NST_CALLBACK SoundUnlock(void* userData, Sound::Output& sound) {
-	// Do Nothing
+	audio_unlock(sound);
 }
 
 static void NST_CALLBACK nst_cb_event(void *userData, User::Event event, const void* data) {
@@ -746,6 +746,28 @@ void nst_load_db() {
 	}
 }
 
+bool nst_convert_db(const char *infile, const char *outfile) {
+	// Convert an XML database to the binary format loaded at startup
+	Nes::Api::Emulator converter;
+	Nes::Api::Cartridge::Database database(converter);
+	
+	std::ifstream xml(infile, std::ifstream::in|std::ifstream::binary);
+	
+	if (!xml.is_open() || NES_FAILED(database.Load(xml))) {
+		fprintf(stderr, "Error: Could not load database %s\n", infile);
+		return false;
+	}
+	
+	std::ofstream bin(outfile, std::ofstream::out|std::ofstream::binary);
+	
+	if (!bin.is_open() || NES_FAILED(database.Save(bin)) || !bin.flush()) {
+		fprintf(stderr, "Error: Could not write %s\n", outfile);
+		return false;
+	}
+	
+	return true;
+}
+
 void nst_load_fds_bios() {
 	// Load the Famicom Disk System BIOS
 	Nes::Api::Fds fds(emulator);
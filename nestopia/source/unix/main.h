@@ -18,6 +18,7 @@ bool nst_archive_checkext(const char *filename);
 bool nst_archive_handle(const char *filename, char **rom, int *romsize, const char *reqfile);
 bool nst_find_patch(char *filename);
 void nst_load_db();
+bool nst_convert_db(const char *infile, const char *outfile);
 void nst_load_fds_bios();
 void nst_load_palette(const char *filename);
 void nst_load(const char *filename);
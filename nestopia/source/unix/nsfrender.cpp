@@ -0,0 +1,283 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2012-2017 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+// Headless NSF renderer: renders tracks straight to WAV files, one
+// emulator instance per worker thread, without opening any devices.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "core/api/NstApiEmulator.hpp"
+#include "core/api/NstApiMachine.hpp"
+#include "core/api/NstApiSound.hpp"
+#include "core/api/NstApiNsf.hpp"
+
+#include "config.h"
+#include "nsfrender.h"
+
+using namespace Nes::Api;
+
+extern settings_t conf;
+
+typedef struct {
+	const char *filename;
+	int track; // Zero based
+	std::string outfile;
+} nsfrender_job_t;
+
+static std::vector<nsfrender_job_t> jobs;
+static nsfrender_t *rendersettings;
+static SDL_atomic_t nextjob;
+static SDL_atomic_t failures;
+
+void nsfrender_set_default(nsfrender_t *settings) {
+	settings->outdir = NULL;
+	settings->tracks = NULL;
+	settings->length = 180;
+	settings->silence = 3;
+	settings->jobs = 0;
+}
+
+static bool nsfrender_load(Emulator& emulator, const char *filename) {
+	// Load the NSF and start the machine
+	std::ifstream file(filename, std::ifstream::in|std::ifstream::binary);
+
+	if (!file.is_open()) { return false; }
+
+	Machine machine(emulator);
+
+	if (NES_FAILED(machine.Load(file, Machine::FAVORED_NES_NTSC))) {
+		return false;
+	}
+
+	if (!machine.Is(Machine::SOUND)) {
+		machine.Unload();
+		return false;
+	}
+
+	machine.SetMode(machine.GetDesiredMode());
+
+	Sound sound(emulator);
+	sound.SetSampleBits(16);
+	sound.SetSampleRate(conf.audio_sample_rate);
+	sound.SetSpeaker(conf.audio_stereo ? Sound::SPEAKER_STEREO : Sound::SPEAKER_MONO);
+
+	machine.Power(true);
+
+	return true;
+}
+
+static void nsfrender_write_le(FILE *fp, unsigned long value, int bytes) {
+	for (int i = 0; i < bytes; i++) {
+		fputc((value >> (i * 8)) & 0xFF, fp);
+	}
+}
+
+static bool nsfrender_write_wav(const char *filename, const int16_t *samples, unsigned long length, int channels) {
+	// Write 16-bit PCM samples to a WAV file
+	FILE *fp = fopen(filename, "wb");
+
+	if (!fp) { return false; }
+
+	unsigned long datasize = length * channels * 2;
+
+	fwrite("RIFF", 1, 4, fp);
+	nsfrender_write_le(fp, 36 + datasize, 4);
+	fwrite("WAVEfmt ", 1, 8, fp);
+	nsfrender_write_le(fp, 16, 4);
+	nsfrender_write_le(fp, 1, 2); // PCM
+	nsfrender_write_le(fp, channels, 2);
+	nsfrender_write_le(fp, conf.audio_sample_rate, 4);
+	nsfrender_write_le(fp, conf.audio_sample_rate * channels * 2, 4);
+	nsfrender_write_le(fp, channels * 2, 2);
+	nsfrender_write_le(fp, 16, 2);
+	fwrite("data", 1, 4, fp);
+	nsfrender_write_le(fp, datasize, 4);
+
+	// Samples are little-endian on every platform this builds on
+	bool ok = fwrite(samples, channels * 2, length, fp) == length;
+
+	return (fclose(fp) == 0) && ok;
+}
+
+static int nsfrender_worker(void *data) {
+	// Render jobs until the queue runs dry
+	Emulator emulator;
+
+	int channels = conf.audio_stereo ? 2 : 1;
+	unsigned long length = (unsigned long)rendersettings->length * conf.audio_sample_rate;
+	unsigned long silence = (unsigned long)rendersettings->silence * conf.audio_sample_rate;
+
+	std::vector<int16_t> buffer(length * channels);
+
+	const char *loaded = NULL;
+
+	for (int i; (i = SDL_AtomicAdd(&nextjob, 1)) < (int)jobs.size();) {
+		nsfrender_job_t& job = jobs[i];
+
+		// Consecutive jobs are usually tracks of the same file, keep it loaded
+		if (loaded != job.filename) {
+			if (loaded) { Machine(emulator).Unload(); }
+			loaded = nsfrender_load(emulator, job.filename) ? job.filename : NULL;
+		}
+
+		// Selecting and playing a song runs its init routine from scratch
+		Nsf nsf(emulator);
+
+		if (!loaded || NES_FAILED(nsf.SelectSong(job.track)) || NES_FAILED(nsf.PlaySong())) {
+			fprintf(stderr, "Error: Could not play track %d of %s\n", job.track + 1, job.filename);
+			SDL_AtomicAdd(&failures, 1);
+			continue;
+		}
+
+		unsigned long rendered = nsf.Render(&buffer[0], length, silence);
+
+		nsf.StopSong();
+
+		if (!nsfrender_write_wav(job.outfile.c_str(), &buffer[0], rendered, channels)) {
+			fprintf(stderr, "Error: Could not write %s\n", job.outfile.c_str());
+			SDL_AtomicAdd(&failures, 1);
+			continue;
+		}
+
+		fprintf(stderr, "%s: track %d, %.1fs -> %s\n", job.filename, job.track + 1,
+			(double)rendered / conf.audio_sample_rate, job.outfile.c_str());
+	}
+
+	if (loaded) { Machine(emulator).Unload(); }
+
+	return 0;
+}
+
+static bool nsfrender_parse_tracks(const char *list, int numsongs, std::vector<int>& tracks) {
+	// Expand a track list such as "1,3-5" into zero based track numbers
+	if (!list) {
+		for (int i = 0; i < numsongs; i++) { tracks.push_back(i); }
+		return true;
+	}
+
+	const char *p = list;
+
+	while (*p) {
+		char *end;
+		long first = strtol(p, &end, 10);
+		long last = first;
+
+		if (end == p) { return false; }
+
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+			if (end == p) { return false; }
+		}
+
+		if (first < 1 || last < first) { return false; }
+
+		for (long i = first; i <= last && i <= numsongs; i++) {
+			tracks.push_back(i - 1);
+		}
+
+		if (*end == ',') { end++; }
+		else if (*end) { return false; }
+
+		p = end;
+	}
+
+	return true;
+}
+
+int nsfrender_run(nsfrender_t *settings, int numfiles, char *files[]) {
+	// Render the selected tracks of every file, returns the exit status
+	if (numfiles < 1) {
+		fprintf(stderr, "Error: No NSF files given\n");
+		return 1;
+	}
+
+	if (settings->length < 1) {
+		fprintf(stderr, "Error: Invalid track length\n");
+		return 1;
+	}
+
+	rendersettings = settings;
+
+	// Probe every file for its song count to build the job queue
+	Emulator emulator;
+
+	for (int i = 0; i < numfiles; i++) {
+		if (!nsfrender_load(emulator, files[i])) {
+			fprintf(stderr, "Error: Could not load NSF %s\n", files[i]);
+			return 1;
+		}
+
+		std::vector<int> tracks;
+
+		if (!nsfrender_parse_tracks(settings->tracks, Nsf(emulator).GetNumSongs(), tracks)) {
+			fprintf(stderr, "Error: Invalid track list\n");
+			return 1;
+		}
+
+		Machine(emulator).Unload();
+
+		std::string base(files[i]);
+		base.erase(0, base.find_last_of('/') + 1);
+		base.erase(base.find_last_of('.') == std::string::npos ? base.size() : base.find_last_of('.'));
+
+		for (size_t t = 0; t < tracks.size(); t++) {
+			char suffix[16];
+			snprintf(suffix, sizeof(suffix), "-%02d.wav", tracks[t] + 1);
+
+			nsfrender_job_t job;
+			job.filename = files[i];
+			job.track = tracks[t];
+			job.outfile = std::string(settings->outdir) + "/" + base + suffix;
+			jobs.push_back(job);
+		}
+	}
+
+	int numthreads = settings->jobs > 0 ? settings->jobs : SDL_GetCPUCount();
+	if (numthreads > (int)jobs.size()) { numthreads = jobs.size(); }
+
+	SDL_AtomicSet(&nextjob, 0);
+	SDL_AtomicSet(&failures, 0);
+
+	std::vector<SDL_Thread*> threads;
+
+	for (int i = 0; i < numthreads; i++) {
+		SDL_Thread *thread = SDL_CreateThread(nsfrender_worker, "nsfrender", NULL);
+		if (thread) { threads.push_back(thread); }
+	}
+
+	// Fall back to rendering on this thread if none could be started
+	if (threads.empty() && !jobs.empty()) { nsfrender_worker(NULL); }
+
+	for (size_t i = 0; i < threads.size(); i++) {
+		SDL_WaitThread(threads[i], NULL);
+	}
+
+	return SDL_AtomicGet(&failures) ? 1 : 0;
+}
@@ -0,0 +1,15 @@
+#ifndef _NSFRENDER_H_
+#define _NSFRENDER_H_
+
+typedef struct {
+	const char *outdir; // Directory the WAV files are written to
+	const char *tracks; // Track list such as "1,3-5", NULL for all tracks
+	int length; // Maximum length of a track in seconds
+	int silence; // Seconds of silence that end a track, 0 to disable
+	int jobs; // Number of worker threads, 0 for one per CPU
+} nsfrender_t;
+
+void nsfrender_set_default(nsfrender_t *settings);
+int nsfrender_run(nsfrender_t *settings, int numfiles, char *files[]);
+
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2012-2017 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+// Library scanner: identifies every image under a set of directories and
+// writes an index the frontend can load in place of opening each file.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "core/api/NstApiEmulator.hpp"
+#include "core/api/NstApiCartridge.hpp"
+#include "core/api/NstApiScanner.hpp"
+
+#include "main.h"
+#include "scanner.h"
+
+using namespace Nes::Api;
+
+extern Emulator emulator;
+
+typedef struct {
+	std::string filename;
+	unsigned long size;
+	unsigned long time;
+	Scanner::Info info;
+	bool ok;
+} scanner_job_t;
+
+static std::vector<scanner_job_t> jobs;
+static SDL_atomic_t nextjob;
+
+static bool scanner_checkext(const char *filename) {
+	// Check if the file has one of the extensions the scanner reads
+	static const char *extensions[] = { ".nes", ".unf", ".unif", ".fds", ".nsf" };
+	const char *ext = strrchr(filename, '.');
+
+	if (!ext) { return false; }
+
+	for (size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++) {
+		if (!strcasecmp(ext, extensions[i])) { return true; }
+	}
+
+	return false;
+}
+
+static void scanner_walk(const std::string& dirname, const Scanner::Index& cached, Scanner::Index& index) {
+	// Queue every image below a directory, unchanged files are taken from the old index
+	DIR *dir = opendir(dirname.c_str());
+
+	if (!dir) {
+		fprintf(stderr, "Error: Could not open directory %s\n", dirname.c_str());
+		return;
+	}
+
+	while (struct dirent *entry = readdir(dir)) {
+		if (entry->d_name[0] == '.') { continue; }
+
+		std::string filename = dirname + "/" + entry->d_name;
+		struct stat st;
+
+		if (stat(filename.c_str(), &st)) { continue; }
+
+		if (S_ISDIR(st.st_mode)) {
+			scanner_walk(filename, cached, index);
+			continue;
+		}
+
+		if (!S_ISREG(st.st_mode) || !scanner_checkext(entry->d_name)) { continue; }
+
+		const Scanner::Index::Entry *old = cached.Find(filename.c_str());
+
+		if (old && old->size == (unsigned long)st.st_size && old->time == (unsigned long)st.st_mtime) {
+			index.Insert(filename.c_str(), old->size, old->time, old->info);
+			continue;
+		}
+
+		scanner_job_t job;
+		job.filename = filename;
+		job.size = st.st_size;
+		job.time = st.st_mtime;
+		job.ok = false;
+		jobs.push_back(job);
+	}
+
+	closedir(dir);
+}
+
+static int scanner_worker(void *data) {
+	// Identify and hash files until the queue runs dry
+	for (int i; (i = SDL_AtomicAdd(&nextjob, 1)) < (int)jobs.size();) {
+		scanner_job_t& job = jobs[i];
+
+		std::ifstream file(job.filename.c_str(), std::ifstream::in|std::ifstream::binary);
+
+		job.ok = file.is_open() && NES_SUCCEEDED(Scanner::Read(file, job.info));
+	}
+
+	return 0;
+}
+
+int scanner_run(const char *indexfile, int numjobs, int numdirs, char *dirs[]) {
+	// Scan the directories and write the index, returns the exit status
+	if (numdirs < 1) {
+		fprintf(stderr, "Error: No directories given\n");
+		return 1;
+	}
+
+	// Files that haven't changed since the last scan are not read again
+	Scanner::Index cached, index;
+
+	std::ifstream oldindex(indexfile, std::ifstream::in|std::ifstream::binary);
+
+	if (oldindex.is_open()) {
+		cached.Load(oldindex);
+		oldindex.close();
+	}
+
+	for (int i = 0; i < numdirs; i++) {
+		std::string dirname(dirs[i]);
+		while (dirname.size() > 1 && dirname[dirname.size() - 1] == '/') { dirname.erase(dirname.size() - 1); }
+		scanner_walk(dirname, cached, index);
+	}
+
+	unsigned long reused = index.NumEntries();
+
+	int numthreads = numjobs > 0 ? numjobs : SDL_GetCPUCount();
+	if (numthreads > (int)jobs.size()) { numthreads = jobs.size(); }
+
+	SDL_AtomicSet(&nextjob, 0);
+
+	std::vector<SDL_Thread*> threads;
+
+	for (int i = 0; i < numthreads; i++) {
+		SDL_Thread *thread = SDL_CreateThread(scanner_worker, "scanner", NULL);
+		if (thread) { threads.push_back(thread); }
+	}
+
+	// Fall back to scanning on this thread if none could be started
+	if (threads.empty() && !jobs.empty()) { scanner_worker(NULL); }
+
+	for (size_t i = 0; i < threads.size(); i++) {
+		SDL_WaitThread(threads[i], NULL);
+	}
+
+	// Database lookups aren't thread-safe, match the results here
+	nst_load_db();
+
+	Cartridge::Database database(emulator);
+	int matched = 0;
+	int failed = 0;
+
+	for (size_t i = 0; i < jobs.size(); i++) {
+		scanner_job_t& job = jobs[i];
+
+		if (!job.ok) {
+			fprintf(stderr, "Error: Could not identify %s\n", job.filename.c_str());
+			failed++;
+			continue;
+		}
+
+		if (database.IsLoaded() && Scanner::Match(database, job.info)) { matched++; }
+
+		index.Insert(job.filename.c_str(), job.size, job.time, job.info);
+	}
+
+	std::ofstream out(indexfile, std::ofstream::out|std::ofstream::binary);
+
+	if (!out.is_open() || NES_FAILED(index.Save(out)) || !out.flush()) {
+		fprintf(stderr, "Error: Could not write %s\n", indexfile);
+		return 1;
+	}
+
+	fprintf(stderr, "%lu images indexed: %lu unchanged, %d scanned, %d found in the database, %d failed\n",
+		index.NumEntries(), reused, (int)jobs.size() - failed, matched, failed);
+
+	return 0;
+}
@@ -0,0 +1,6 @@
+#ifndef _SCANNER_H_
+#define _SCANNER_H_
+
+int scanner_run(const char *indexfile, int jobs, int numdirs, char *dirs[]);
+
+#endif